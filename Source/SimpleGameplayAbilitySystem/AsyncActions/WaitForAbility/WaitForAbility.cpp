@@ -107,7 +107,7 @@ void UWaitForAbility::Activate()
 	}
 
 	// Activate the sub ability
-	ActivatedAbilityID = FGuid::NewGuid();
+	ActivatedAbilityID = ActivatorAbility->OwningAbilityComponent->MakeNetID();
 	ActivatorAbility->OwningAbilityComponent->ActivateAbilityWithID(
 		ActivatedAbilityID,
 		AbilityClass,
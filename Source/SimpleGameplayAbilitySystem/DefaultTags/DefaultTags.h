@@ -16,6 +16,7 @@ class FDefaultTags
 		static FGameplayTag AbilityEnded() { return FindTag("SimpleGAS.Events.Ability.Ended"); }
 		static FGameplayTag AbilityEndedSuccessfully() { return FindTag("SimpleGAS.Events.Ability.Ended.Success"); }
 		static FGameplayTag AbilityCancelled() { return FindTag("SimpleGAS.Events.Ability.Ended.Cancel"); }
+		static FGameplayTag AbilityCooldownEnded() { return FindTag("SimpleGAS.Events.Ability.CooldownEnded"); }
 	
 		static FGameplayTag WaitForAbilityEnded() { return FindTag("SimpleGAS.Events.Ability.WaitForAbilityEnded"); }
 	
@@ -35,6 +36,8 @@ class FDefaultTags
 		static FGameplayTag StructAttributeAdded() { return FindTag("SimpleGAS.Events.Attributes.Added.Struct"); }
 		static FGameplayTag StructAttributeValueChanged() { return FindTag("SimpleGAS.Events.Attributes.Changed.Struct"); }
 		static FGameplayTag StructAttributeRemoved() { return FindTag("SimpleGAS.Events.Attributes.Removed.Struct"); }
+	
+		static FGameplayTag AttributesChanged() { return FindTag("SimpleGAS.Events.Attributes.BatchChanged"); }
 		
 		// Domains
 		static FGameplayTag LocalAbilityDomain() { return FindTag("SimpleGAS.Domains.Ability.Local"); }
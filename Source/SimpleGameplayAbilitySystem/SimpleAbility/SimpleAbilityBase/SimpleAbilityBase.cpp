@@ -27,7 +27,7 @@ void USimpleAbilityBase::TakeStateSnapshot(FGameplayTag SnapshotTag, FInstancedS
 	NewSnapshot.AbilityID = AbilityInstanceID;
 	NewSnapshot.SnapshotTag = SnapshotTag;
 	NewSnapshot.StateData = SnapshotData;
-	NewSnapshot.TimeStamp = OwningAbilityComponent->GetServerTime();
+	NewSnapshot.TimeStamp = OwningAbilityComponent->GetCachedServerTime();
 
 	// Store the delegate in a map
 	if (OnResolved.IsBound())
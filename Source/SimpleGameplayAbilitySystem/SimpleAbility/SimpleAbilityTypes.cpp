@@ -0,0 +1,58 @@
+#include "SimpleAbilityTypes.h"
+
+namespace SimpleActivationNetSerialization
+{
+	constexpr double TicksPerSecond = 100.0;
+	constexpr uint32 NumPolicyBits = 3;
+}
+
+uint16 FSimpleAbilityActivationNetRequest::QuantizeActivationTime(const double ActivationTime)
+{
+	using namespace SimpleActivationNetSerialization;
+	
+	return static_cast<uint16>(FMath::RoundToInt64(ActivationTime * TicksPerSecond) & 0xFFFF);
+}
+
+double FSimpleAbilityActivationNetRequest::DequantizeActivationTime(const uint16 QuantizedTime, const double ServerTime)
+{
+	using namespace SimpleActivationNetSerialization;
+	
+	// The signed difference between the server's ticks and the sent ticks tells us how far in the past (or future) the activation was
+	const uint16 ServerTicks = static_cast<uint16>(FMath::RoundToInt64(ServerTime * TicksPerSecond) & 0xFFFF);
+	const int16 TickDifference = static_cast<int16>(ServerTicks - QuantizedTime);
+
+	return ServerTime - TickDifference / TicksPerSecond;
+}
+
+bool FSimpleAbilityActivationNetRequest::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	using namespace SimpleActivationNetSerialization;
+	
+	bOutSuccess = true;
+
+	uint32 ClassIndex = static_cast<uint32>(FMath::Max(AbilityClassIndex, 0));
+	Ar.SerializeIntPacked(ClassIndex);
+	AbilityClassIndex = static_cast<int32>(ClassIndex);
+
+	FSimpleNetID::SerializeID(Ar, AbilityID);
+
+	uint8 Policy = static_cast<uint8>(ActivationPolicy);
+	Ar.SerializeBits(&Policy, NumPolicyBits);
+	ActivationPolicy = static_cast<EAbilityActivationPolicy>(Policy);
+
+	uint8 HasContext = AbilityContext.IsValid() ? 1 : 0;
+	Ar.SerializeBits(&HasContext, 1);
+
+	if (!HasContext)
+	{
+		AbilityContext.Reset();
+		return true;
+	}
+
+	// FInstancedStruct uses the context struct's own NetSerialize if it has one
+	bool ContextSuccess = true;
+	AbilityContext.NetSerialize(Ar, Map, ContextSuccess);
+	bOutSuccess &= ContextSuccess;
+
+	return true;
+}
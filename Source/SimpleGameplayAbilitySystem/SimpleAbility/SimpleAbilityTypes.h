@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameplayTagContainer.h"
 #include "Net/Serialization/FastArraySerializer.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleNetID.h"
 
 #if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5)
 	#include "StructUtils/InstancedStruct.h"
@@ -165,6 +166,10 @@ struct FSimpleAbilitySnapshot
 	bool WasClientSnapshotResolved = false;
 };
 
+/**
+ * The compact, frequently read part of an ability or attribute modifier state.
+ * Status changes only dirty this record so they replicate without resending any contexts or snapshots.
+ */
 USTRUCT(BlueprintType)
 struct FAbilityState : public FFastArraySerializerItem
 {
@@ -182,17 +187,12 @@ struct FAbilityState : public FFastArraySerializerItem
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	double ActivationTimeStamp;
 
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-	FInstancedStruct ActivationContext;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-	FInstancedStruct EndingContext;
-
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
 	EAbilityStatus AbilityStatus = EAbilityStatus::PreActivation;
 
+	// True if this state was created with a valid activation context, which is stored in the matching FAbilityStatePayload
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-	TArray<FSimpleAbilitySnapshot> SnapshotHistory;
+	bool HasActivationContext = false;
 
 	bool operator==(const FAbilityState& Other) const
 	{
@@ -264,6 +264,84 @@ struct TStructOpsTypeTraits<FAbilityStateContainer> : public TStructOpsTypeTrait
 	};
 };
 
+/**
+ * The heavy part of an ability or attribute modifier state, keyed by the same AbilityID as its FAbilityState.
+ * Only created once there is something to store (a valid activation context, an ending context or a snapshot).
+ */
+USTRUCT(BlueprintType)
+struct FAbilityStatePayload : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	FGuid AbilityID;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FInstancedStruct ActivationContext;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FInstancedStruct EndingContext;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	TArray<FSimpleAbilitySnapshot> SnapshotHistory;
+
+	bool operator==(const FAbilityStatePayload& Other) const
+	{
+		return AbilityID == Other.AbilityID;
+	}
+};
+
+DECLARE_DELEGATE_OneParam(FOnAbilityStatePayloadAdded, const FAbilityStatePayload&);
+DECLARE_DELEGATE_OneParam(FOnAbilityStatePayloadChanged, const FAbilityStatePayload&);
+
+USTRUCT()
+struct FAbilityStatePayloadContainer : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	TArray<FAbilityStatePayload> Payloads;
+
+	FOnAbilityStatePayloadAdded   OnAbilityStatePayloadAdded;
+	FOnAbilityStatePayloadChanged OnAbilityStatePayloadChanged;
+	
+	void PostReplicatedAdd(const TArrayView< int32 >& AddedIndices, int32 FinalSize)
+	{
+		if (OnAbilityStatePayloadAdded.IsBound())
+		{
+			for (const int32 AddedIndex : AddedIndices)
+			{
+				OnAbilityStatePayloadAdded.Execute(Payloads[AddedIndex]);
+			}
+		}
+	}
+	
+	void PostReplicatedChange(const TArrayView< int32 >& ChangedIndices, int32 FinalSize)
+	{
+		if (OnAbilityStatePayloadChanged.IsBound())
+		{
+			for (const int32 ChangedIndex : ChangedIndices)
+			{
+				OnAbilityStatePayloadChanged.Execute(Payloads[ChangedIndex]);
+			}
+		}
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo & DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FAbilityStatePayload, FAbilityStatePayloadContainer>(Payloads, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FAbilityStatePayloadContainer> : public TStructOpsTypeTraitsBase2<FAbilityStatePayloadContainer>
+{
+	enum 
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
 USTRUCT(BlueprintType)
 struct FSimpleAbilityEndedEvent
 {
@@ -285,6 +363,76 @@ struct FSimpleAbilityEndedEvent
 	bool WasCancelled;
 };
 
+/* A single entry for USimpleGameplayAbilityComponent::ActivateAbilities */
+USTRUCT(BlueprintType)
+struct FSimpleAbilityActivationRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TSubclassOf<USimpleGameplayAbility> AbilityClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FInstancedStruct AbilityContext;
+
+	/* Optional. If left invalid a new ID is generated for the activation. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FGuid AbilityID;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool OverrideActivationPolicy = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (EditCondition = "OverrideActivationPolicy"))
+	EAbilityActivationPolicy ActivationPolicyOverride = EAbilityActivationPolicy::LocalOnly;
+};
+
+/**
+ * The compact activation request clients send to the server. The ability class is sent as its index in the component's
+ * ActivatableAbilityClasses and the ability ID as a compact ID (see FSimpleNetID) when possible.
+ */
+USTRUCT()
+struct FSimpleAbilityActivationNetRequest
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 AbilityClassIndex = INDEX_NONE;
+
+	UPROPERTY()
+	FGuid AbilityID;
+
+	UPROPERTY()
+	FInstancedStruct AbilityContext;
+
+	UPROPERTY()
+	EAbilityActivationPolicy ActivationPolicy = EAbilityActivationPolicy::LocalOnly;
+
+	/**
+	 * Activation times are sent as 16 bits of 1/100 second ticks and rebuilt around the server's current time,
+	 * which works as long as the client and server clocks are within ~5 minutes of each other.
+	 */
+	static uint16 QuantizeActivationTime(double ActivationTime);
+	static double DequantizeActivationTime(uint16 QuantizedTime, double ServerTime);
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FSimpleAbilityActivationNetRequest> : public TStructOpsTypeTraitsBase2<FSimpleAbilityActivationNetRequest>
+{
+	enum 
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/* The server requests collected by USimpleGameplayAbilityComponent::ActivateAbilities so they can be sent together */
+struct FSimpleAbilityActivationBatch
+{
+	TArray<FSimpleAbilityActivationNetRequest> CompactRequests;
+	TArray<FSimpleAbilityActivationRequest> Requests;
+};
+
 /* Delegates */
 
 DECLARE_DYNAMIC_DELEGATE_FourParams(
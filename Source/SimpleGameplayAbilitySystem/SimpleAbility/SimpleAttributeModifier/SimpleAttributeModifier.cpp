@@ -6,6 +6,7 @@
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleGameplayAbility/SimpleGameplayAbility.h"
 #include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubSystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
+#include "SimpleGameplayAbilitySystem/SimpleModifierScheduler/SimpleModifierSchedulerSubsystem.h"
 
 class USimpleEventSubsystem;
 
@@ -35,11 +36,12 @@ bool USimpleAttributeModifier::CanApplyModifierInternal(FInstancedStruct Modifie
 		return false;
 	}
 
-	// if (USimpleAttributeFunctionLibrary::HasModifierWithTags(TargetAbilityComponent, TargetBlockingModifierTags))
-	// {
-	// 	UE_LOG(LogSimpleGAS, Warning, TEXT("Target has blocking modifier tags in USimpleAttributeModifier::CanApplyModifierInternal"));
-	// 	return false;
-	// }
+	// Skipped while this modifier is running so its own tags don't block its ticks
+	if (!bIsModifierActive && TargetAbilityComponent->HasActiveModifierWithTags(TargetBlockingModifierTags))
+	{
+		UE_LOG(LogSimpleGAS, Warning, TEXT("Target has blocking modifier tags in USimpleAttributeModifier::CanApplyModifierInternal"));
+		return false;
+	}
 
 	return true;
 }
@@ -94,6 +96,8 @@ bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* In
 	// Set up for duration type modifiers
 	if (ModifierType == EAttributeModifierType::Duration)
 	{
+		Target->RegisterActiveModifier(this);
+
 		// Listen for tag changes on the target ability component
 		if (USimpleEventSubsystem* EventSubsystem = Instigator->GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>())
 		{
@@ -115,53 +119,15 @@ bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* In
 			TargetAbilityComponent->AddGameplayTag(Tag, FInstancedStruct());
 		}
 
-		// If the whole modifier has a duration we set a timer to end it
-		if (Duration > 0 && !HasInfiniteDuration)
+		// The scheduler ends the modifier once its duration runs out and ticks it every TickInterval
+		if (USimpleModifierSchedulerSubsystem* ModifierScheduler = GetModifierScheduler())
 		{
-			Instigator->GetWorld()->GetTimerManager().SetTimer(
-				DurationTimerHandle,
-				[this]()
-				{
-					EndModifier(FDefaultTags::AbilityEndedSuccessfully(), FInstancedStruct());
-				},
-				Duration,
-				false
-			);	
+			ModifierScheduler->RegisterModifier(this, HasInfiniteDuration ? 0.0f : Duration, TickInterval);
 		}
 
-		if (TickInterval > 0)
+		if (CanStack && !HasInfiniteDuration && StackDurationPolicy == EAttributeModifierStackDurationPolicy::IndependentStacks)
 		{
-			Instigator->GetWorld()->GetTimerManager().SetTimer(
-				TickTimerHandle,
-				[this]()
-				{
-					if (!CanApplyModifierInternal(InitialModifierContext))
-					{
-						switch (TickTagRequirementBehaviour)
-						{
-							case EDurationTickTagRequirementBehaviour::CancelOnTagRequirementFailed:
-								ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickCancel);
-								EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
-								return;
-							case EDurationTickTagRequirementBehaviour::SkipOnTagRequirementFailed:
-								UE_LOG(LogSimpleGAS, Warning, TEXT("[USimpleAttributeModifier::ApplyModifier]: tag requirement failed on tick. Skipping modification."));
-								return;
-							case EDurationTickTagRequirementBehaviour::PauseOnTagRequirementFailed:
-								InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(DurationTimerHandle);
-								InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(TickTimerHandle);
-								return;
-						}
-					}
-
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(DurationTimerHandle);
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(TickTimerHandle);
-					
-					ApplyModifiersInternal(EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
-					ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
-				},
-				TickInterval,
-				true
-			);
+			StackExpiryTimes.Init(Duration, FMath::Max(Stacks, 0));
 		}
 
 		if (TickOnApply)
@@ -189,8 +155,9 @@ bool USimpleAttributeModifier::ApplyModifier(USimpleGameplayAbilityComponent* In
 bool USimpleAttributeModifier::ApplyModifiersInternal(const EAttributeModifierSideEffectTrigger TriggerPhase)
 {
 	// We process the modifier stack as a transaction to avoid partial changes of attributes
-	TArray<FFloatAttribute> TempFloatAttributes = TargetAbilityComponent->AuthorityFloatAttributes.Attributes;
-	TArray<FStructAttribute> TempStructAttributes = TargetAbilityComponent->AuthorityStructAttributes.Attributes;
+	TArray<FFloatAttribute> TempFloatAttributes;
+	TArray<FStructAttribute> TempStructAttributes;
+	TargetAbilityComponent->CopyAuthorityAttributes(TempFloatAttributes, TempStructAttributes);
 
 	TArray<FGameplayTag> ModifiedFloatAttributes;
 	TArray<FGameplayTag> ModifiedStructAttributes;
@@ -256,8 +223,15 @@ bool USimpleAttributeModifier::ApplyModifiersInternal(const EAttributeModifierSi
 
 void USimpleAttributeModifier::EndModifier(const FGameplayTag EndingStatus, const FInstancedStruct EndingContext)
 {
-	InstigatorAbilityComponent->GetWorld()->GetTimerManager().ClearTimer(DurationTimerHandle);
-	InstigatorAbilityComponent->GetWorld()->GetTimerManager().ClearTimer(TickTimerHandle);
+	if (USimpleModifierSchedulerSubsystem* ModifierScheduler = GetModifierScheduler())
+	{
+		ModifierScheduler->UnregisterModifier(this);
+	}
+
+	if (TargetAbilityComponent)
+	{
+		TargetAbilityComponent->UnregisterActiveModifier(this);
+	}
 
 	if (USimpleEventSubsystem* EventSubsystem = InstigatorAbilityComponent->GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>())
 	{
@@ -306,6 +280,11 @@ void USimpleAttributeModifier::EndModifier(const FGameplayTag EndingStatus, cons
 	
 	OnModifierEnded(EndingStatus, EndingContext);
 	bIsModifierActive = false;
+
+	if (OwningAbilityComponent)
+	{
+		OwningAbilityComponent->ReleaseAttributeModifier(this);
+	}
 }
 
 void USimpleAttributeModifier::CleanUpAbility_Implementation()
@@ -345,15 +324,144 @@ void USimpleAttributeModifier::AddModifierStack(int32 StackCount)
 		if (Stacks + StackCount > MaxStacks)
 		{
 			Stacks = MaxStacks;
+			UpdateStackDuration(StackCount);
 			OnMaxStacksReached();
 			return;
 		}
 	}
 
 	Stacks += StackCount;
+	UpdateStackDuration(StackCount);
 	OnStacksAdded(StackCount, Stacks);
 }
 
+void USimpleAttributeModifier::ExpireDuration()
+{
+	USimpleModifierSchedulerSubsystem* ModifierScheduler = GetModifierScheduler();
+
+	if (ModifierScheduler && StackDurationPolicy == EAttributeModifierStackDurationPolicy::IndependentStacks && StackExpiryTimes.Num() > 1)
+	{
+		const float ActiveTime = ModifierScheduler->GetModifierActiveTime(this);
+
+		// The oldest stack is always due when this is called, the ones after it may be due as well
+		int32 NumExpiredStacks = 1;
+
+		while (NumExpiredStacks < StackExpiryTimes.Num() && StackExpiryTimes[NumExpiredStacks] <= ActiveTime)
+		{
+			NumExpiredStacks++;
+		}
+
+		if (NumExpiredStacks < StackExpiryTimes.Num())
+		{
+			StackExpiryTimes.RemoveAt(0, NumExpiredStacks);
+			Stacks = StackExpiryTimes.Num();
+			ModifierScheduler->SetModifierDuration(this, StackExpiryTimes[0] - ActiveTime);
+			OnStacksRemoved(NumExpiredStacks, Stacks);
+			return;
+		}
+	}
+
+	EndModifier(FDefaultTags::AbilityEndedSuccessfully(), FInstancedStruct());
+}
+
+void USimpleAttributeModifier::UpdateStackDuration(const int32 AddedStacks)
+{
+	if (!bIsModifierActive || ModifierType != EAttributeModifierType::Duration || HasInfiniteDuration)
+	{
+		return;
+	}
+
+	USimpleModifierSchedulerSubsystem* ModifierScheduler = GetModifierScheduler();
+
+	if (!ModifierScheduler)
+	{
+		return;
+	}
+
+	switch (StackDurationPolicy)
+	{
+		case EAttributeModifierStackDurationPolicy::KeepDuration:
+			break;
+
+		case EAttributeModifierStackDurationPolicy::RefreshDuration:
+			if (AddedStacks > 0)
+			{
+				ModifierScheduler->SetModifierDuration(this, Duration);
+			}
+			break;
+
+		case EAttributeModifierStackDurationPolicy::ExtendDuration:
+			if (AddedStacks > 0)
+			{
+				ModifierScheduler->SetModifierDuration(this, ModifierScheduler->GetModifierRemainingDuration(this) + Duration * AddedStacks);
+			}
+			break;
+
+		case EAttributeModifierStackDurationPolicy::IndependentStacks:
+		{
+			const float ActiveTime = ModifierScheduler->GetModifierActiveTime(this);
+
+			for (int32 i = 0; i < AddedStacks; i++)
+			{
+				StackExpiryTimes.Add(ActiveTime + Duration);
+			}
+
+			// Stacks over the max replace the oldest ones
+			if (StackExpiryTimes.Num() > Stacks)
+			{
+				StackExpiryTimes.RemoveAt(0, StackExpiryTimes.Num() - FMath::Max(Stacks, 0));
+			}
+
+			if (StackExpiryTimes.Num() > 0)
+			{
+				ModifierScheduler->SetModifierDuration(this, StackExpiryTimes[0] - ActiveTime);
+			}
+			break;
+		}
+	}
+}
+
+void USimpleAttributeModifier::ResetModifier()
+{
+	Stacks = GetClass()->GetDefaultObject<USimpleAttributeModifier>()->Stacks;
+	bIsModifierActive = false;
+	InitialModifierContext.Reset();
+	StackExpiryTimes.Reset();
+	InstigatorAbilityComponent = nullptr;
+	TargetAbilityComponent = nullptr;
+	AbilityInstanceID.Invalidate();
+	SnapshotSequenceCounter = 0;
+	SnapshotResolveCallbacks.Empty();
+
+	OnModifierReset();
+}
+
+void USimpleAttributeModifier::TickDurationModifier()
+{
+	if (!CanApplyModifierInternal(InitialModifierContext))
+	{
+		switch (TickTagRequirementBehaviour)
+		{
+			case EDurationTickTagRequirementBehaviour::CancelOnTagRequirementFailed:
+				ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickCancel);
+				EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
+				return;
+			case EDurationTickTagRequirementBehaviour::SkipOnTagRequirementFailed:
+				UE_LOG(LogSimpleGAS, Warning, TEXT("[USimpleAttributeModifier::TickDurationModifier]: tag requirement failed on tick. Skipping modification."));
+				return;
+			case EDurationTickTagRequirementBehaviour::PauseOnTagRequirementFailed:
+				if (USimpleModifierSchedulerSubsystem* ModifierScheduler = GetModifierScheduler())
+				{
+					ModifierScheduler->SetModifierPaused(this, true);
+				}
+				return;
+		}
+	}
+
+	ApplyModifiersInternal(EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
+	ApplySideEffects(InstigatorAbilityComponent, TargetAbilityComponent, EAttributeModifierSideEffectTrigger::OnDurationModifierTickSuccess);
+}
+
 bool USimpleAttributeModifier::ApplyFloatAttributeModifier(const FFloatAttributeModifier& FloatModifier, TArray<FFloatAttribute>& TempFloatAttributes, float& CurrentOverflow)
 {
 	FFloatAttribute* AttributeToModify = GetTempFloatAttribute(FloatModifier.AttributeToModify, TempFloatAttributes);
@@ -436,6 +544,25 @@ bool USimpleAttributeModifier::ApplyFloatAttributeModifier(const FFloatAttribute
 		
 	}
 
+	if (FloatModifier.ScaleWithStacks && CanStack && Stacks > 1)
+	{
+		switch (FloatModifier.ModificationOperation)
+		{
+			case EFloatAttributeModificationOperation::Add:
+			case EFloatAttributeModificationOperation::Subtract:
+				ModificationInputValue *= Stacks;
+				break;
+			
+			case EFloatAttributeModificationOperation::Multiply:
+			case EFloatAttributeModificationOperation::Divide:
+				ModificationInputValue = FMath::Pow(ModificationInputValue, static_cast<float>(Stacks));
+				break;
+			
+			default:
+				break;
+		}
+	}
+
 	// Next up we get the current value of the attribute
 	float CurrentAttributeValue = 0;
 	switch (FloatModifier.ModifiedAttributeValueType)
@@ -604,7 +731,7 @@ void USimpleAttributeModifier::ApplySideEffects(USimpleGameplayAbilityComponent*
 			AbilitySideEffect.AbilityContext = Payload;
 			ModifierResult.AppliedAbilitySideEffects.Add(AbilitySideEffect);
 
-			FGuid AbilityID = FGuid::NewGuid();
+			FGuid AbilityID = ActivatingAbilityComponent->MakeNetID();
 			
 			switch (AbilitySideEffect.ActivationPolicy)
 			{
@@ -689,7 +816,7 @@ void USimpleAttributeModifier::ApplySideEffects(USimpleGameplayAbilityComponent*
 			FInstancedStruct Payload = FInstancedStruct();
 			UFunctionSelectors::GetStructContext(this, AttributeSideEffect.ContextFunction, Payload);
 
-			FGuid AttributeID = FGuid::NewGuid();
+			FGuid AttributeID = InstigatingAbilityComponent->MakeNetID();
 			InstigatingAbilityComponent->ApplyAttributeModifierToTarget(TargetedAbilityComponent, AttributeSideEffect.AttributeModifierClass, Payload, AttributeID);
 			
 			AttributeSideEffect.ModifierContext = Payload;
@@ -708,7 +835,7 @@ void USimpleAttributeModifier::ApplySideEffects(USimpleGameplayAbilityComponent*
 	FSimpleAbilitySnapshot Snapshot;
 	Snapshot.AbilityID = AbilityInstanceID;
 	Snapshot.SnapshotTag = FDefaultTags::AttributeModifierApplied();
-	Snapshot.TimeStamp = OwningAbilityComponent->GetServerTime();
+	Snapshot.TimeStamp = OwningAbilityComponent->GetCachedServerTime();
 
 	// ApplyServerOnly means we don't want to replicate any side effects so we clear the modifier result
 	if (OwningAbilityComponent->HasAuthority())
@@ -751,6 +878,12 @@ FStructAttribute* USimpleAttributeModifier::GetTempStructAttribute(const FGamepl
 	return nullptr;
 }
 
+USimpleModifierSchedulerSubsystem* USimpleAttributeModifier::GetModifierScheduler() const
+{
+	const UWorld* World = InstigatorAbilityComponent ? InstigatorAbilityComponent->GetWorld() : GetWorld();
+	return World ? World->GetSubsystem<USimpleModifierSchedulerSubsystem>() : nullptr;
+}
+
 void USimpleAttributeModifier::OnTagsChanged(FGameplayTag EventTag, FGameplayTag Domain, FInstancedStruct Payload, UObject* Sender)
 {
 	if (ModifierType == EAttributeModifierType::Duration && bIsModifierActive)
@@ -765,14 +898,18 @@ void USimpleAttributeModifier::OnTagsChanged(FGameplayTag EventTag, FGameplayTag
 				case EDurationTickTagRequirementBehaviour::SkipOnTagRequirementFailed:
 					return;
 				case EDurationTickTagRequirementBehaviour::PauseOnTagRequirementFailed:
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(DurationTimerHandle);
-					InstigatorAbilityComponent->GetWorld()->GetTimerManager().PauseTimer(TickTimerHandle);
+					if (USimpleModifierSchedulerSubsystem* ModifierScheduler = GetModifierScheduler())
+					{
+						ModifierScheduler->SetModifierPaused(this, true);
+					}
 					return;
 			}
 		}
-		
-		InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(DurationTimerHandle);
-		InstigatorAbilityComponent->GetWorld()->GetTimerManager().UnPauseTimer(TickTimerHandle);
+
+		if (USimpleModifierSchedulerSubsystem* ModifierScheduler = GetModifierScheduler())
+		{
+			ModifierScheduler->SetModifierPaused(this, false);
+		}
 	}
 }
 
@@ -789,7 +926,7 @@ void USimpleAttributeModifier::ClientFastForwardState(FGameplayTag StateTag, FSi
 	for (const FAbilitySideEffect& AuthoritySideEffect : AuthorityModifierResult->AppliedAbilitySideEffects)
 	{
 		USimpleGameplayAbilityComponent* ActivatingAbilityComponent = AuthoritySideEffect.ActivatingAbilityComponent == EAttributeModifierSideEffectTarget::Instigator ? AuthorityModifierResult->Instigator : AuthorityModifierResult->Target;
-		ActivatingAbilityComponent->ActivateAbilityWithID(FGuid::NewGuid(), AuthoritySideEffect.AbilityClass, AuthoritySideEffect.AbilityContext, true, AuthoritySideEffect.ActivationPolicy);
+		ActivatingAbilityComponent->ActivateAbilityWithID(ActivatingAbilityComponent->MakeNetID(), AuthoritySideEffect.AbilityClass, AuthoritySideEffect.AbilityContext, true, AuthoritySideEffect.ActivationPolicy);
 	}
 }
 
@@ -821,7 +958,7 @@ void USimpleAttributeModifier::ClientResolvePastState(FGameplayTag StateTag, FSi
         {
             // Activate the side effect that was not predicted
             USimpleGameplayAbilityComponent* ActivatingAbilityComponent = AuthoritySideEffect.ActivatingAbilityComponent == EAttributeModifierSideEffectTarget::Instigator ? InstigatorAbilityComponent : TargetAbilityComponent;
-            ActivatingAbilityComponent->ActivateAbilityWithID(FGuid::NewGuid(), AuthoritySideEffect.AbilityClass, AuthoritySideEffect.AbilityContext, true, AuthoritySideEffect.ActivationPolicy);
+            ActivatingAbilityComponent->ActivateAbilityWithID(ActivatingAbilityComponent->MakeNetID(), AuthoritySideEffect.AbilityClass, AuthoritySideEffect.AbilityContext, true, AuthoritySideEffect.ActivationPolicy);
         }
     }
 
@@ -6,6 +6,7 @@
 #include "SimpleAttributeModifier.generated.h"
 
 class USimpleGameplayAbility;
+class USimpleModifierSchedulerSubsystem;
 
 UCLASS(Blueprintable)
 class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleAttributeModifier : public USimpleAbilityBase
@@ -61,6 +62,12 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attribute Modifier|Config|Duration Config|Stacking Config", meta = (EditCondition = "ModifierType == EAttributeModifierType::Duration && CanStack && HasMaxStacks"))
 	int32 MaxStacks;
 
+	/**
+	 * How adding stacks changes the duration of the modifier. Only used if the modifier doesn't have an infinite duration.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Attribute Modifier|Config|Duration Config|Stacking Config", meta = (EditCondition = "ModifierType == EAttributeModifierType::Duration && CanStack && !HasInfiniteDuration"))
+	EAttributeModifierStackDurationPolicy StackDurationPolicy = EAttributeModifierStackDurationPolicy::KeepDuration;
+
 	/**
 	 * These tags must be present on the target ability component for this modifier to apply.
 	 */
@@ -150,6 +157,15 @@ public:
 	
 	UFUNCTION(BlueprintCallable, Category = "Attribute Modifier|Lifecycle")
 	void AddModifierStack(int32 StackCount);
+
+	/* Clears the state left over from the last application so a pooled instance can be applied again. */
+	virtual void ResetModifier();
+
+	/* Called by USimpleModifierSchedulerSubsystem every TickInterval while the duration modifier is active and not paused. */
+	void TickDurationModifier();
+
+	/* Called by USimpleModifierSchedulerSubsystem when the duration runs out. Ends the modifier or, with IndependentStacks, its oldest stacks. */
+	void ExpireDuration();
 	
 	/* Blueprint Implementable Events */
 	
@@ -168,9 +184,18 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "Attribute Modifier|Lifecycle")
 	void OnMaxStacksReached();
 
+	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable, Category = "Attribute Modifier|Lifecycle")
+	void OnStacksRemoved(int32 RemovedStacks, int32 CurrentStacks);
+
+	/* Called when a pooled instance is about to be applied again. Reset any variables set during the last application here. */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Attribute Modifier|Lifecycle")
+	void OnModifierReset();
+
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Attribute Modifier|Utility")
 	bool IsModifierActive() const { return bIsModifierActive; }
 
+	USimpleGameplayAbilityComponent* GetTargetAbilityComponent() const { return TargetAbilityComponent; }
+
 	virtual void ClientFastForwardState(FGameplayTag StateTag, FSimpleAbilitySnapshot LatestAuthorityState) override;
 	virtual void ClientResolvePastState(FGameplayTag StateTag, FSimpleAbilitySnapshot AuthorityState, FSimpleAbilitySnapshot PredictedState) override;
 protected:
@@ -191,7 +216,9 @@ private:
 	FInstancedStruct InitialModifierContext;
 	FFloatAttribute* GetTempFloatAttribute(const FGameplayTag AttributeTag, TArray<FFloatAttribute>& TempFloatAttributes) const;
 	FStructAttribute* GetTempStructAttribute(const FGameplayTag AttributeTag, TArray<FStructAttribute>& TempStructAttributes) const;
-	
-	FTimerHandle DurationTimerHandle;
-	FTimerHandle TickTimerHandle;
+	USimpleModifierSchedulerSubsystem* GetModifierScheduler() const;
+	void UpdateStackDuration(int32 AddedStacks);
+
+	// With IndependentStacks, the active time (see USimpleModifierSchedulerSubsystem::GetModifierActiveTime) each stack ends at, oldest first
+	TArray<float> StackExpiryTimes;
 };
@@ -97,6 +97,28 @@ enum class EDurationTickTagRequirementBehaviour : uint8
 	CancelOnTagRequirementFailed,
 };
 
+UENUM(BlueprintType)
+enum class EAttributeModifierStackDurationPolicy : uint8
+{
+	/**
+	 * Adding stacks doesn't change when the modifier ends.
+	 */
+	KeepDuration,
+	/**
+	 * Adding stacks restarts the modifier's duration. All stacks end together.
+	 */
+	RefreshDuration,
+	/**
+	 * Every added stack adds Duration to the time the modifier has left.
+	 */
+	ExtendDuration,
+	/**
+	 * Every stack ends Duration seconds after it was added. The modifier ends when its last stack does.
+	 * Adding stacks past MaxStacks replaces the oldest ones.
+	 */
+	IndependentStacks,
+};
+
 /* Structs */
 
 USTRUCT(BlueprintType)
@@ -150,6 +172,14 @@ struct FFloatAttributeModifier
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	EFloatAttributeModificationOperation ModificationOperation;
 
+	/**
+	 * If true, the input value is scaled by the stack count of a stacking modifier. Add and Subtract multiply the input by
+	 * the stack count, Multiply and Divide raise it to the power of the stack count (e.g. 3 stacks of x1.1 multiply by 1.331).
+	 * Override, Power and Custom have no meaningful way to stack and ignore this.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool ScaleWithStacks = false;
+
 	UPROPERTY(EditAnywhere, meta=(EditCondition = "ModificationOperation == EFloatAttributeModificationOperation::Custom", EditConditionHides, FunctionReference, AllowFunctionLibraries, PrototypeFunction="/Script/SimpleGameplayAbilitySystem.FunctionSelectors.Prototype_ApplyFloatAttributeOperation", DefaultBindingName="CustomFloatOperation"))
 	FMemberReference FloatOperationFunction;
 };
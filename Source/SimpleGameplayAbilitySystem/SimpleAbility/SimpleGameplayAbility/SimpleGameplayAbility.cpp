@@ -2,6 +2,7 @@
 
 #include "SimpleGameplayAbilitySystem/DefaultTags/DefaultTags.h"
 #include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleAbilityTickSubsystem/SimpleAbilityTickSubsystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubSystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
 
@@ -52,6 +53,7 @@ bool USimpleGameplayAbility::ActivateAbility(const FGuid AbilityID, FInstancedSt
 	OwningAbilityComponent->SetAbilityStatus(AbilityInstanceID, EAbilityStatus::ActivationSuccess);
 	CachedActivationContext = ActivationContext;
 	bIsAbilityActive = true;
+	SetTickRegistered(true);
 	
 	PreActivate(ActivationContext);
 	OnActivate(ActivationContext);
@@ -117,7 +119,7 @@ FGuid USimpleGameplayAbility::ActivateSubAbility(
 		break;
 	}
 
-	const FGuid SubAbilityID = FGuid::NewGuid();
+	const FGuid SubAbilityID = OwningAbilityComponent->MakeNetID();
 
 	if (CancelIfParentEnds)
 	{
@@ -205,6 +207,7 @@ void USimpleGameplayAbility::EndAbilityInternal(FGameplayTag Status, FInstancedS
 	}
 	
 	bIsAbilityActive = false;
+	SetTickRegistered(false);
 
 	if (InstancingPolicy == EAbilityInstancingPolicy::MultipleInstances)
 	{
@@ -292,7 +295,7 @@ double USimpleGameplayAbility::GetActivationTime() const
 
 double USimpleGameplayAbility::GetActivationDelay() const
 {
-	return OwningAbilityComponent->GetServerTime() - GetActivationTime();
+	return OwningAbilityComponent->GetCachedServerTime() - GetActivationTime();
 }
 
 FInstancedStruct USimpleGameplayAbility::GetActivationContext() const
@@ -334,26 +337,28 @@ UWorld* USimpleGameplayAbility::GetWorld() const
 	return nullptr;
 }
 
-void USimpleGameplayAbility::Tick(float DeltaTime)
+void USimpleGameplayAbility::SetTickRegistered(const bool ShouldTick)
 {
-	OnTick(DeltaTime);
-}
+	if (!CanTick)
+	{
+		return;
+	}
 
-bool USimpleGameplayAbility::IsTickable() const
-{
-	UWorld* World = GetWorld();
-	return CanTick && IsAbilityActive() && World != nullptr;
-}
+	USimpleAbilityTickSubsystem* TickSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USimpleAbilityTickSubsystem>() : nullptr;
 
-TStatId USimpleGameplayAbility::GetStatId() const
-{
-	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleGameplayAbility, STATGROUP_Tickables);
-}
+	if (!TickSubsystem)
+	{
+		return;
+	}
 
-ETickableTickType USimpleGameplayAbility::GetTickableTickType() const
-{
-	// Only tick during gameplay, not in editor
-	return ETickableTickType::Conditional;
+	if (ShouldTick)
+	{
+		TickSubsystem->RegisterAbility(this);
+	}
+	else
+	{
+		TickSubsystem->UnregisterAbility(this);
+	}
 }
 
 bool USimpleGameplayAbility::MeetsActivationRequirements(FInstancedStruct& ActivationContext)
@@ -2,19 +2,23 @@
 
 #include "CoreMinimal.h"
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAbilityBase/SimpleAbilityBase.h"
-#include "Tickable.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleAbilityComponentTypes.h"
 #include "SimpleGameplayAbility.generated.h"
 
 UCLASS(Blueprintable)
-class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleGameplayAbility : public USimpleAbilityBase, public FTickableGameObject
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleGameplayAbility : public USimpleAbilityBase
 {
 	GENERATED_BODY()
 
 public:
+	/* If true, OnTick is called while this ability is active. Ticking is batched per ability class by USimpleAbilityTickSubsystem. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Tick")
 	bool CanTick = false;
 
+	/* How many times per second OnTick is called. 0 ticks every frame. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Tick", meta = (EditCondition = "CanTick", ClampMin = "0"))
+	float TickRate = 0.0f;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Activation")
 	EAbilityActivationPolicy ActivationPolicy = EAbilityActivationPolicy::LocalOnly;
 
@@ -29,9 +33,14 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Activation")
 	FGameplayTagContainer ActivationBlockingTags;
 
+	/* The base cooldown of this ability. Can be changed at runtime by overriding GetAbilityCooldownDuration on the ability component. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability|Activation")
 	float Cooldown = 0.0f;
 
+	/* If set, all abilities with the same cooldown tag share one cooldown instead of each ability class having its own. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Activation")
+	FGameplayTag CooldownTag;
+
 	/* If set, this ability will only activate if it receives an ActivationContext of this struct type. */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Ability|Activation")
 	UScriptStruct* RequiredContextType;
@@ -170,12 +179,6 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	bool IsAbilityActive() const;
 
-	// FTickableGameObject overrides
-	virtual void Tick(float DeltaTime) override;
-	virtual bool IsTickable() const override;
-	virtual TStatId GetStatId() const override;
-	virtual ETickableTickType GetTickableTickType() const override;
-
 	/**
 	 * Returns the server time this ability was activated at.
 	 * If called from the Server Initiated ability it returns the authoritative time.
@@ -220,6 +223,7 @@ private:
 	TArray<FGuid> EndOnCancelledSubAbilities;
 
 	bool MeetsActivationRequirements(FInstancedStruct& ActivationContext);
+	void SetTickRegistered(bool ShouldTick);
 	bool bIsAbilityActive = false;
 	FInstancedStruct CachedActivationContext;
 };
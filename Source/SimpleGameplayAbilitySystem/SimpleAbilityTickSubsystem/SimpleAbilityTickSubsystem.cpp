@@ -0,0 +1,168 @@
+#include "SimpleAbilityTickSubsystem.h"
+
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleGameplayAbility/SimpleGameplayAbility.h"
+
+void USimpleAbilityTickSubsystem::RegisterAbility(USimpleGameplayAbility* Ability)
+{
+	if (!Ability)
+	{
+		return;
+	}
+
+	// Adding a group while the groups are iterated would invalidate the iteration, so registrations wait until the tick is done
+	if (IsTicking)
+	{
+		PendingRegistrations.AddUnique(Ability);
+		return;
+	}
+
+	UClass* AbilityClass = Ability->GetClass();
+	FSimpleAbilityTickGroup* TickGroup = TickGroups.Find(AbilityClass);
+
+	if (!TickGroup)
+	{
+		TickGroup = &TickGroups.Add(AbilityClass);
+
+		const float* TickRateOverride = TickRateOverrides.Find(AbilityClass);
+		TickGroup->TickInterval = TickRateToInterval(TickRateOverride ? *TickRateOverride : Ability->TickRate);
+	}
+
+	if (TickGroup->Abilities.Contains(Ability))
+	{
+		return;
+	}
+
+	TickGroup->Abilities.Add(Ability);
+	NumRegisteredAbilities++;
+}
+
+void USimpleAbilityTickSubsystem::UnregisterAbility(USimpleGameplayAbility* Ability)
+{
+	if (!Ability)
+	{
+		return;
+	}
+
+	PendingRegistrations.RemoveSingleSwap(Ability);
+
+	FSimpleAbilityTickGroup* TickGroup = TickGroups.Find(Ability->GetClass());
+
+	if (!TickGroup)
+	{
+		return;
+	}
+
+	const int32 AbilityIndex = TickGroup->Abilities.Find(Ability);
+
+	if (AbilityIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Only clear the entry here since this can be called while the group is being ticked. It's removed after the next tick.
+	TickGroup->Abilities[AbilityIndex].Reset();
+	TickGroup->HasStaleEntries = true;
+}
+
+void USimpleAbilityTickSubsystem::SetTickRateForClass(TSubclassOf<USimpleGameplayAbility> AbilityClass, const float TicksPerSecond)
+{
+	if (!AbilityClass)
+	{
+		return;
+	}
+
+	TickRateOverrides.Add(AbilityClass, TicksPerSecond);
+
+	if (FSimpleAbilityTickGroup* TickGroup = TickGroups.Find(AbilityClass))
+	{
+		TickGroup->TickInterval = TickRateToInterval(TicksPerSecond);
+	}
+}
+
+void USimpleAbilityTickSubsystem::Deinitialize()
+{
+	TickGroups.Empty();
+	TickRateOverrides.Empty();
+	PendingRegistrations.Empty();
+	NumRegisteredAbilities = 0;
+	Super::Deinitialize();
+}
+
+void USimpleAbilityTickSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (NumRegisteredAbilities <= 0)
+	{
+		return;
+	}
+
+	IsTicking = true;
+
+	for (TPair<UClass*, FSimpleAbilityTickGroup>& TickGroupPair : TickGroups)
+	{
+		FSimpleAbilityTickGroup& TickGroup = TickGroupPair.Value;
+
+		if (TickGroup.Abilities.Num() == 0)
+		{
+			continue;
+		}
+
+		TickGroup.TimeSinceLastTick += DeltaTime;
+
+		if (TickGroup.TimeSinceLastTick < TickGroup.TickInterval)
+		{
+			continue;
+		}
+
+		const float GroupDeltaTime = TickGroup.TimeSinceLastTick;
+		TickGroup.TimeSinceLastTick = 0.0f;
+
+		for (int32 i = 0; i < TickGroup.Abilities.Num(); i++)
+		{
+			if (USimpleGameplayAbility* Ability = TickGroup.Abilities[i].Get())
+			{
+				Ability->OnTick(GroupDeltaTime);
+			}
+			else
+			{
+				TickGroup.HasStaleEntries = true;
+			}
+		}
+	}
+
+	IsTicking = false;
+
+	// Abilities registered while ticking get their first tick next time
+	for (const TWeakObjectPtr<USimpleGameplayAbility>& PendingAbility : PendingRegistrations)
+	{
+		RegisterAbility(PendingAbility.Get());
+	}
+
+	PendingRegistrations.Reset();
+
+	for (TPair<UClass*, FSimpleAbilityTickGroup>& TickGroupPair : TickGroups)
+	{
+		FSimpleAbilityTickGroup& TickGroup = TickGroupPair.Value;
+
+		if (!TickGroup.HasStaleEntries)
+		{
+			continue;
+		}
+
+		NumRegisteredAbilities -= TickGroup.Abilities.Num();
+		TickGroup.Abilities.RemoveAllSwap([](const TWeakObjectPtr<USimpleGameplayAbility>& Ability) { return !Ability.IsValid(); });
+		NumRegisteredAbilities += TickGroup.Abilities.Num();
+		TickGroup.HasStaleEntries = false;
+	}
+}
+
+TStatId USimpleAbilityTickSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleAbilityTickSubsystem, STATGROUP_Tickables);
+}
+
+float USimpleAbilityTickSubsystem::TickRateToInterval(const float TicksPerSecond)
+{
+	return TicksPerSecond > 0.0f ? 1.0f / TicksPerSecond : 0.0f;
+}
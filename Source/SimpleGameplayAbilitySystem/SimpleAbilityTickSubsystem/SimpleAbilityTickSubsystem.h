@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SimpleAbilityTickSubsystem.generated.h"
+
+class USimpleGameplayAbility;
+
+/* All ticking abilities of one class. They share a tick rate and are ticked together. */
+USTRUCT()
+struct FSimpleAbilityTickGroup
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TWeakObjectPtr<USimpleGameplayAbility>> Abilities;
+
+	// Seconds between ticks. 0 ticks every frame.
+	float TickInterval = 0.0f;
+	float TimeSinceLastTick = 0.0f;
+	
+	// Set when an ability unregisters so the group gets compacted after the next tick
+	bool HasStaleEntries = false;
+};
+
+/**
+ * Ticks every active ability that has CanTick enabled. Abilities are grouped by class and each group is ticked in one batch
+ * at the tick rate set on the ability class (or overridden with SetTickRateForClass), so idle abilities cost nothing per frame.
+ */
+UCLASS()
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleAbilityTickSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	void RegisterAbility(USimpleGameplayAbility* Ability);
+	void UnregisterAbility(USimpleGameplayAbility* Ability);
+
+	/**
+	 * Overrides the tick rate of every ability of this class in this world.
+	 * @param AbilityClass The ability class to change the tick rate of
+	 * @param TicksPerSecond How often the abilities tick. 0 ticks every frame.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleGAS|Tick")
+	void SetTickRateForClass(TSubclassOf<USimpleGameplayAbility> AbilityClass, float TicksPerSecond);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	static float TickRateToInterval(float TicksPerSecond);
+	
+	UPROPERTY()
+	TMap<UClass*, FSimpleAbilityTickGroup> TickGroups;
+
+	// Tick rates set with SetTickRateForClass, kept so groups created later use them too
+	UPROPERTY()
+	TMap<UClass*, float> TickRateOverrides;
+	
+	// Includes unregistered entries that haven't been removed from their group yet
+	int32 NumRegisteredAbilities = 0;
+
+	// Abilities registered from inside an ability tick, added to their groups once the tick is done
+	TArray<TWeakObjectPtr<USimpleGameplayAbility>> PendingRegistrations;
+	bool IsTicking = false;
+};
@@ -0,0 +1,46 @@
+#include "SimpleEventRelayComponent.h"
+
+#include "GameFramework/PlayerController.h"
+#include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubsystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
+
+USimpleEventRelayComponent::USimpleEventRelayComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+USimpleEventRelayComponent* USimpleEventRelayComponent::FindRelay(const APlayerController* PlayerController)
+{
+	return PlayerController ? PlayerController->FindComponentByClass<USimpleEventRelayComponent>() : nullptr;
+}
+
+void USimpleEventRelayComponent::ClientRelayEvent_Implementation(USimpleGameplayAbilityComponent* SourceComponent,
+	FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender,
+	ESimpleEventReplicationPolicy ReplicationPolicy)
+{
+	// Going through the source component lets it skip events it already predicted
+	if (SourceComponent)
+	{
+		SourceComponent->SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, {});
+		return;
+	}
+
+	USimpleEventSubsystem* EventSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>();
+
+	if (!EventSubsystem)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleEventRelayComponent::ClientRelayEvent]: No SimpleEventSubsystem found."));
+		return;
+	}
+
+	EventSubsystem->SendEvent(EventTag, DomainTag, Payload, Sender, {});
+}
+
+void USimpleEventRelayComponent::ClientRelayEventUnreliable_Implementation(USimpleGameplayAbilityComponent* SourceComponent,
+	FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender,
+	ESimpleEventReplicationPolicy ReplicationPolicy)
+{
+	ClientRelayEvent_Implementation(SourceComponent, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy);
+}
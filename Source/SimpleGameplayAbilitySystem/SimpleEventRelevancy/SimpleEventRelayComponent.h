@@ -0,0 +1,46 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Components/ActorComponent.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleAbilityComponentTypes.h"
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5)
+	#include "StructUtils/InstancedStruct.h"
+#else
+	#include "InstancedStruct.h"
+#endif
+
+#include "SimpleEventRelayComponent.generated.h"
+
+class APlayerController;
+class USimpleGameplayAbilityComponent;
+
+/**
+ * Delivers events that use a relevancy policy to a single client.
+ * Add it to the PlayerController. Clients without one don't receive events that use a relevancy policy.
+ */
+UCLASS(Blueprintable, ClassGroup=(AbilityComponent), meta=(BlueprintSpawnableComponent))
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleEventRelayComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USimpleEventRelayComponent();
+
+	static USimpleEventRelayComponent* FindRelay(const APlayerController* PlayerController);
+
+	/**
+	 * Sends an event from SourceComponent to this client.
+	 * SourceComponent can arrive as null if its actor isn't relevant to the client, the event is still sent then.
+	 */
+	UFUNCTION(Client, Reliable)
+	void ClientRelayEvent(
+		USimpleGameplayAbilityComponent* SourceComponent, FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag,
+		const FInstancedStruct& Payload, UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy);
+
+	UFUNCTION(Client, Unreliable)
+	void ClientRelayEventUnreliable(
+		USimpleGameplayAbilityComponent* SourceComponent, FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag,
+		const FInstancedStruct& Payload, UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy);
+};
@@ -0,0 +1,70 @@
+#include "SimpleEventRelevancyPolicy.h"
+
+#include "GenericTeamAgentInterface.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
+
+bool USimpleEventRelevancyPolicy::IsRelevantTo_Implementation(
+	const USimpleGameplayAbilityComponent* SourceComponent, const APlayerController* Receiver,
+	FGameplayTag EventTag, const FInstancedStruct& Payload) const
+{
+	return true;
+}
+
+const AActor* USimpleEventRelevancyPolicy::GetSourceActor(const USimpleGameplayAbilityComponent* SourceComponent)
+{
+	if (!SourceComponent)
+	{
+		return nullptr;
+	}
+
+	if (const AActor* AvatarActor = SourceComponent->GetAvatarActor())
+	{
+		return AvatarActor;
+	}
+
+	return SourceComponent->GetOwner();
+}
+
+bool USimpleEventRadiusRelevancy::IsRelevantTo_Implementation(
+	const USimpleGameplayAbilityComponent* SourceComponent, const APlayerController* Receiver,
+	FGameplayTag EventTag, const FInstancedStruct& Payload) const
+{
+	const AActor* SourceActor = GetSourceActor(SourceComponent);
+
+	if (!SourceActor || !Receiver)
+	{
+		return false;
+	}
+
+	// Same view point the engine uses for actor relevancy
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	Receiver->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	return FVector::DistSquared(SourceActor->GetActorLocation(), ViewLocation) <= FMath::Square(Radius);
+}
+
+bool USimpleEventTeamRelevancy::IsRelevantTo_Implementation(
+	const USimpleGameplayAbilityComponent* SourceComponent, const APlayerController* Receiver,
+	FGameplayTag EventTag, const FInstancedStruct& Payload) const
+{
+	const AActor* SourceActor = GetSourceActor(SourceComponent);
+
+	if (!SourceActor || !Receiver)
+	{
+		return false;
+	}
+
+	FGenericTeamId ReceiverTeam = FGenericTeamId::GetTeamIdentifier(Receiver);
+
+	if (ReceiverTeam == FGenericTeamId::NoTeam && Receiver->GetPawn())
+	{
+		ReceiverTeam = FGenericTeamId::GetTeamIdentifier(Receiver->GetPawn());
+	}
+
+	const bool IsSameTeam = ReceiverTeam != FGenericTeamId::NoTeam && ReceiverTeam == FGenericTeamId::GetTeamIdentifier(SourceActor);
+
+	return SendToOtherTeams ? !IsSameTeam : IsSameTeam;
+}
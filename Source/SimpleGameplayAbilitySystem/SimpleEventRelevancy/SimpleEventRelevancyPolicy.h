@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 5)
+	#include "StructUtils/InstancedStruct.h"
+#else
+	#include "InstancedStruct.h"
+#endif
+
+#include "UObject/Object.h"
+#include "SimpleEventRelevancyPolicy.generated.h"
+
+class APlayerController;
+class USimpleGameplayAbilityComponent;
+
+/**
+ * Decides which clients receive an AllConnectedClients event instead of multicasting it to everyone.
+ * Policies are used through their class default object, so subclass one (e.g. in Blueprint) to change its settings.
+ * Events with a relevancy policy are sent to each relevant client through the SimpleEventRelayComponent on their PlayerController.
+ */
+UCLASS(Blueprintable, Abstract)
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleEventRelevancyPolicy : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called on the server for every remote client when an event using this policy is replicated.
+	 * @param SourceComponent The ability component sending the event
+	 * @param Receiver The PlayerController of the client that would receive the event
+	 * @return True if the event should be sent to this client
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "SimpleGAS|EventRelevancy")
+	bool IsRelevantTo(
+		const USimpleGameplayAbilityComponent* SourceComponent, const APlayerController* Receiver,
+		FGameplayTag EventTag, const FInstancedStruct& Payload) const;
+	virtual bool IsRelevantTo_Implementation(
+		const USimpleGameplayAbilityComponent* SourceComponent, const APlayerController* Receiver,
+		FGameplayTag EventTag, const FInstancedStruct& Payload) const;
+
+protected:
+	/* Returns the avatar actor of the component, or its owner if it has no avatar. */
+	static const AActor* GetSourceActor(const USimpleGameplayAbilityComponent* SourceComponent);
+};
+
+/* Sends the event to clients whose view point is within Radius of the sending avatar. */
+UCLASS(Blueprintable)
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleEventRadiusRelevancy : public USimpleEventRelevancyPolicy
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SimpleGAS|EventRelevancy", meta = (ClampMin = "0"))
+	float Radius = 3000.0f;
+
+	virtual bool IsRelevantTo_Implementation(
+		const USimpleGameplayAbilityComponent* SourceComponent, const APlayerController* Receiver,
+		FGameplayTag EventTag, const FInstancedStruct& Payload) const override;
+};
+
+/**
+ * Sends the event to clients on the same team as the sending avatar.
+ * Teams come from IGenericTeamAgentInterface on the avatar and on the receiving PlayerController or its pawn.
+ */
+UCLASS(Blueprintable)
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleEventTeamRelevancy : public USimpleEventRelevancyPolicy
+{
+	GENERATED_BODY()
+
+public:
+	/* If true, the event goes to every team except the sender's instead. */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SimpleGAS|EventRelevancy")
+	bool SendToOtherTeams = false;
+
+	virtual bool IsRelevantTo_Implementation(
+		const USimpleGameplayAbilityComponent* SourceComponent, const APlayerController* Receiver,
+		FGameplayTag EventTag, const FInstancedStruct& Payload) const override;
+};
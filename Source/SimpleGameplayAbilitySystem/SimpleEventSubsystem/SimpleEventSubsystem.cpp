@@ -1,5 +1,6 @@
 #include "SimpleEventSubSystem.h"
 #include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleNetID.h"
 
 void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload, UObject* Sender, TArray<UObject*> ListenerFilter)
 {
@@ -30,40 +31,9 @@ void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag Domain
 			continue;
 		}
 
-		if (!Subscription.EventFilter.IsEmpty())
+		if (!MatchesTags(Subscription, EventTag, DomainTag))
 		{
-			if (Subscription.OnlyMatchExactEvent)
-			{
-				if (!Subscription.EventFilter.HasTagExact(EventTag))
-				{
-					continue;
-				}
-			}
-			else
-			{
-				if (!Subscription.EventFilter.HasTag(EventTag))
-				{
-					continue;
-				}
-			}	
-		}
-
-		if (!Subscription.DomainFilter.IsEmpty())
-		{
-			if (Subscription.OnlyMatchExactDomain)
-			{
-				if (!Subscription.DomainFilter.HasTagExact(DomainTag))
-				{
-					continue;
-				}
-			}
-			else
-			{
-				if (!Subscription.DomainFilter.HasTag(DomainTag))
-				{
-					continue;
-				}
-			}	
+			continue;
 		}
 		
 		if (Subscription.PayloadFilter.Num() > 0)
@@ -119,6 +89,39 @@ void USimpleEventSubsystem::SendEvent(FGameplayTag EventTag, FGameplayTag Domain
 	});
 }
 
+bool USimpleEventSubsystem::HasListeners(const FGameplayTag EventTag, const FGameplayTag DomainTag) const
+{
+	return EventSubscriptions.ContainsByPredicate([EventTag, DomainTag](const FEventSubscription& Subscription)
+	{
+		return Subscription.ListenerObject.IsValid() && MatchesTags(Subscription, EventTag, DomainTag);
+	});
+}
+
+bool USimpleEventSubsystem::MatchesTags(const FEventSubscription& Subscription, const FGameplayTag EventTag, const FGameplayTag DomainTag)
+{
+	if (!Subscription.EventFilter.IsEmpty())
+	{
+		const bool MatchesEvent = Subscription.OnlyMatchExactEvent ? Subscription.EventFilter.HasTagExact(EventTag) : Subscription.EventFilter.HasTag(EventTag);
+
+		if (!MatchesEvent)
+		{
+			return false;
+		}
+	}
+
+	if (!Subscription.DomainFilter.IsEmpty())
+	{
+		const bool MatchesDomain = Subscription.OnlyMatchExactDomain ? Subscription.DomainFilter.HasTagExact(DomainTag) : Subscription.DomainFilter.HasTag(DomainTag);
+
+		if (!MatchesDomain)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 FGuid USimpleEventSubsystem::ListenForEvent(UObject* Listener, bool OnlyTriggerOnce, FGameplayTagContainer EventFilter,
                                             FGameplayTagContainer DomainFilter, const FSimpleEventDelegate& EventReceivedDelegate,
                                             TArray<UScriptStruct*> PayloadFilter, TArray<UObject*> SenderFilter, bool OnlyMatchExactEvent,
@@ -138,7 +141,7 @@ FGuid USimpleEventSubsystem::ListenForEvent(UObject* Listener, bool OnlyTriggerO
 		return Subscription.EventSubscriptionID;
 	}
 
-	Subscription.EventSubscriptionID = FGuid::NewGuid();
+	Subscription.EventSubscriptionID = FSimpleNetID::NewID();
 	Subscription.ListenerObject = Listener;
 	Subscription.CallbackDelegate = EventReceivedDelegate;
 	Subscription.EventFilter.AppendTags(EventFilter);
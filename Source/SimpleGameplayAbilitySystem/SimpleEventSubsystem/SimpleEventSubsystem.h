@@ -74,9 +74,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SimpleEventSubsystem")
 	void StopListeningForAllEvents(UObject* Listener);
 
+	/* True if any listener would receive an event with these tags, ignoring the payload, sender and listener filters. */
+	bool HasListeners(FGameplayTag EventTag, FGameplayTag DomainTag) const;
+
 	UPROPERTY(BlueprintAssignable)
 	FOnEventSubscriptionRemoved OnEventSubscriptionRemoved;
 
 private:
+	static bool MatchesTags(const FEventSubscription& Subscription, FGameplayTag EventTag, FGameplayTag DomainTag);
+	
 	TArray<FEventSubscription> EventSubscriptions;
 };
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SimpleAbilityComponentTypes.h"
+
+/* Shared by FFloatAttribute::NetSerialize and the Iris FFloatAttributeNetSerializer so both send the same data. */
+namespace SimpleAttributeNetSerialization
+{
+	/**
+	 * Says which fields are present, not which fields changed. CurrentValue is always sent, BaseValue is skipped when it
+	 * equals CurrentValue and each limit is skipped when it isn't used. A changed attribute is always sent whole, because
+	 * a lost packet is resent with the latest state and a mask relative to the previous send would leave clients stale.
+	 */
+	enum EFloatAttributeNetFlags : uint8
+	{
+		BaseValueDiffers = 1 << 0,
+		Quantized = 1 << 1,
+		UseMinBaseValue = 1 << 2,
+		UseMaxBaseValue = 1 << 3,
+		UseMinCurrentValue = 1 << 4,
+		UseMaxCurrentValue = 1 << 5,
+	};
+
+	constexpr uint32 NumFlagBits = 6;
+	constexpr uint32 NumPrecisionBits = 2;
+
+	inline float GetPrecisionScale(const EAttributeNetPrecision Precision)
+	{
+		switch (Precision)
+		{
+			case EAttributeNetPrecision::Tenth:
+				return 10.0f;
+			case EAttributeNetPrecision::Hundredth:
+				return 100.0f;
+			default:
+				return 1.0f;
+		}
+	}
+
+	inline bool CanQuantize(const float Value, const float Scale)
+	{
+		return FMath::IsFinite(Value) && FMath::Abs(Value * Scale) < static_cast<float>(MAX_int32 >> 1);
+	}
+
+	inline uint8 MakeFlags(const FFloatAttribute& Attribute)
+	{
+		const FValueLimits& Limits = Attribute.ValueLimits;
+		const float Scale = GetPrecisionScale(Attribute.NetPrecision);
+		
+		uint8 Flags = 0;
+		Flags |= Attribute.BaseValue != Attribute.CurrentValue ? BaseValueDiffers : 0;
+		Flags |= Limits.UseMinBaseValue ? UseMinBaseValue : 0;
+		Flags |= Limits.UseMaxBaseValue ? UseMaxBaseValue : 0;
+		Flags |= Limits.UseMinCurrentValue ? UseMinCurrentValue : 0;
+		Flags |= Limits.UseMaxCurrentValue ? UseMaxCurrentValue : 0;
+
+		// Fall back to full floats if a value is too big to quantize
+		if (Attribute.NetPrecision != EAttributeNetPrecision::Full && CanQuantize(Attribute.BaseValue, Scale) && CanQuantize(Attribute.CurrentValue, Scale))
+		{
+			Flags |= Quantized;
+		}
+
+		return Flags;
+	}
+
+	// Quantized values are zigzag encoded so small negative numbers stay small when packed
+	inline uint32 EncodeQuantizedValue(const float Value, const float Scale)
+	{
+		const int32 QuantizedValue = FMath::RoundToInt(Value * Scale);
+		return static_cast<uint32>((QuantizedValue << 1) ^ (QuantizedValue >> 31));
+	}
+
+	inline float DecodeQuantizedValue(const uint32 EncodedValue, const float Scale)
+	{
+		const int32 DecodedValue = static_cast<int32>(EncodedValue >> 1) ^ -static_cast<int32>(EncodedValue & 1);
+		return static_cast<float>(DecodedValue) / Scale;
+	}
+}
@@ -0,0 +1,286 @@
+#include "FloatAttributeNetSerializer.h"
+
+#if UE_WITH_IRIS
+
+#include "GameplayTagsManager.h"
+#include "Iris/ReplicationState/PropertyNetSerializerInfoRegistry.h"
+#include "Iris/Serialization/NetBitStreamReader.h"
+#include "Iris/Serialization/NetBitStreamUtil.h"
+#include "Iris/Serialization/NetBitStreamWriter.h"
+#include "Iris/Serialization/NetSerializerDelegates.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/FloatAttributeNetSerialization.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleAbilityComponentTypes.h"
+
+namespace UE::Net
+{
+	struct FFloatAttributeNetSerializer
+	{
+		static const uint32 Version = 0;
+
+		// Values hold either the raw float bits or the zigzag encoded quantized value, depending on the Quantized flag
+		struct FQuantizedType
+		{
+			uint32 TagNetIndex;
+			uint32 CurrentValue;
+			uint32 BaseValue;
+			uint32 Limits[4];
+			uint8 Flags;
+			uint8 Precision;
+		};
+
+		typedef FFloatAttribute SourceType;
+		typedef FQuantizedType QuantizedType;
+		typedef FFloatAttributeNetSerializerConfig ConfigType;
+
+		static const ConfigType DefaultConfig;
+
+		static void Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args);
+		static void Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args);
+
+		static void Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args);
+		static void Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args);
+
+		static bool IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args);
+		static bool Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args);
+
+	private:
+		class FNetSerializerRegistryDelegates final : private UE::Net::FNetSerializerRegistryDelegates
+		{
+		public:
+			virtual ~FNetSerializerRegistryDelegates();
+
+		private:
+			virtual void OnPreFreezeNetSerializerRegistry() override;
+		};
+
+		static FFloatAttributeNetSerializer::FNetSerializerRegistryDelegates NetSerializerRegistryDelegates;
+	};
+
+	UE_NET_IMPLEMENT_SERIALIZER(FFloatAttributeNetSerializer);
+
+	const FFloatAttributeNetSerializer::ConfigType FFloatAttributeNetSerializer::DefaultConfig;
+	FFloatAttributeNetSerializer::FNetSerializerRegistryDelegates FFloatAttributeNetSerializer::NetSerializerRegistryDelegates;
+
+	static const FName PropertyNetSerializerRegistry_NAME_FloatAttribute("FloatAttribute");
+	UE_NET_IMPLEMENT_NAMED_STRUCT_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_FloatAttribute, FFloatAttributeNetSerializer);
+
+	namespace FloatAttributeNetSerializerPrivate
+	{
+		uint32 FloatToBits(const float Value)
+		{
+			uint32 Bits;
+			FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+			return Bits;
+		}
+
+		float BitsToFloat(const uint32 Bits)
+		{
+			float Value;
+			FMemory::Memcpy(&Value, &Bits, sizeof(Value));
+			return Value;
+		}
+
+		uint32 QuantizeValue(const float Value, const bool IsQuantized, const float Scale)
+		{
+			return IsQuantized ? SimpleAttributeNetSerialization::EncodeQuantizedValue(Value, Scale) : FloatToBits(Value);
+		}
+
+		float DequantizeValue(const uint32 Value, const bool IsQuantized, const float Scale)
+		{
+			return IsQuantized ? SimpleAttributeNetSerialization::DecodeQuantizedValue(Value, Scale) : BitsToFloat(Value);
+		}
+
+		void WriteValue(FNetBitStreamWriter* Writer, const uint32 Value, const bool IsQuantized)
+		{
+			if (IsQuantized)
+			{
+				WritePackedUint32(Writer, Value);
+			}
+			else
+			{
+				Writer->WriteBits(Value, 32);
+			}
+		}
+
+		uint32 ReadValue(FNetBitStreamReader* Reader, const bool IsQuantized)
+		{
+			return IsQuantized ? ReadPackedUint32(Reader) : Reader->ReadBits(32);
+		}
+	}
+
+	void FFloatAttributeNetSerializer::Serialize(FNetSerializationContext& Context, const FNetSerializeArgs& Args)
+	{
+		using namespace SimpleAttributeNetSerialization;
+		using namespace FloatAttributeNetSerializerPrivate;
+
+		const QuantizedType& Value = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		FNetBitStreamWriter* Writer = Context.GetBitStreamWriter();
+		const bool IsQuantized = (Value.Flags & Quantized) != 0;
+
+		WritePackedUint32(Writer, Value.TagNetIndex);
+		Writer->WriteBits(Value.Flags, NumFlagBits);
+
+		if (IsQuantized)
+		{
+			Writer->WriteBits(Value.Precision, NumPrecisionBits);
+		}
+
+		WriteValue(Writer, Value.CurrentValue, IsQuantized);
+
+		if (Value.Flags & BaseValueDiffers)
+		{
+			WriteValue(Writer, Value.BaseValue, IsQuantized);
+		}
+
+		for (int32 LimitIndex = 0; LimitIndex < 4; ++LimitIndex)
+		{
+			if (Value.Flags & (UseMinBaseValue << LimitIndex))
+			{
+				Writer->WriteBits(Value.Limits[LimitIndex], 32);
+			}
+		}
+	}
+
+	void FFloatAttributeNetSerializer::Deserialize(FNetSerializationContext& Context, const FNetDeserializeArgs& Args)
+	{
+		using namespace SimpleAttributeNetSerialization;
+		using namespace FloatAttributeNetSerializerPrivate;
+
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+		FNetBitStreamReader* Reader = Context.GetBitStreamReader();
+
+		QuantizedType Value = {};
+		Value.TagNetIndex = ReadPackedUint32(Reader);
+		Value.Flags = static_cast<uint8>(Reader->ReadBits(NumFlagBits));
+
+		const bool IsQuantized = (Value.Flags & Quantized) != 0;
+
+		if (IsQuantized)
+		{
+			Value.Precision = static_cast<uint8>(Reader->ReadBits(NumPrecisionBits));
+		}
+
+		Value.CurrentValue = ReadValue(Reader, IsQuantized);
+
+		if (Value.Flags & BaseValueDiffers)
+		{
+			Value.BaseValue = ReadValue(Reader, IsQuantized);
+		}
+
+		for (int32 LimitIndex = 0; LimitIndex < 4; ++LimitIndex)
+		{
+			if (Value.Flags & (UseMinBaseValue << LimitIndex))
+			{
+				Value.Limits[LimitIndex] = Reader->ReadBits(32);
+			}
+		}
+
+		Target = Value;
+	}
+
+	void FFloatAttributeNetSerializer::Quantize(FNetSerializationContext& Context, const FNetQuantizeArgs& Args)
+	{
+		using namespace SimpleAttributeNetSerialization;
+		using namespace FloatAttributeNetSerializerPrivate;
+
+		const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+		QuantizedType& Target = *reinterpret_cast<QuantizedType*>(Args.Target);
+
+		QuantizedType Value = {};
+		Value.TagNetIndex = UGameplayTagsManager::Get().GetNetIndexFromTag(Source.AttributeTag);
+		Value.Flags = MakeFlags(Source);
+
+		const bool IsQuantized = (Value.Flags & Quantized) != 0;
+		Value.Precision = IsQuantized ? static_cast<uint8>(Source.NetPrecision) : 0;
+		
+		const float Scale = GetPrecisionScale(Source.NetPrecision);
+		Value.CurrentValue = QuantizeValue(Source.CurrentValue, IsQuantized, Scale);
+		Value.BaseValue = (Value.Flags & BaseValueDiffers) ? QuantizeValue(Source.BaseValue, IsQuantized, Scale) : 0;
+
+		const FValueLimits& Limits = Source.ValueLimits;
+		Value.Limits[0] = Limits.UseMinBaseValue ? FloatToBits(Limits.MinBaseValue) : 0;
+		Value.Limits[1] = Limits.UseMaxBaseValue ? FloatToBits(Limits.MaxBaseValue) : 0;
+		Value.Limits[2] = Limits.UseMinCurrentValue ? FloatToBits(Limits.MinCurrentValue) : 0;
+		Value.Limits[3] = Limits.UseMaxCurrentValue ? FloatToBits(Limits.MaxCurrentValue) : 0;
+
+		Target = Value;
+	}
+
+	void FFloatAttributeNetSerializer::Dequantize(FNetSerializationContext& Context, const FNetDequantizeArgs& Args)
+	{
+		using namespace SimpleAttributeNetSerialization;
+		using namespace FloatAttributeNetSerializerPrivate;
+
+		const QuantizedType& Source = *reinterpret_cast<const QuantizedType*>(Args.Source);
+		SourceType& Target = *reinterpret_cast<SourceType*>(Args.Target);
+
+		const UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+		Target.AttributeTag = FGameplayTag::RequestGameplayTag(TagsManager.GetTagNameFromNetIndex(static_cast<FGameplayTagNetIndex>(Source.TagNetIndex)), false);
+		Target.AttributeName = Target.AttributeTag.GetTagName();
+
+		const bool IsQuantized = (Source.Flags & Quantized) != 0;
+		Target.NetPrecision = IsQuantized ? static_cast<EAttributeNetPrecision>(Source.Precision) : EAttributeNetPrecision::Full;
+		
+		const float Scale = GetPrecisionScale(Target.NetPrecision);
+		Target.CurrentValue = DequantizeValue(Source.CurrentValue, IsQuantized, Scale);
+		Target.BaseValue = (Source.Flags & BaseValueDiffers) ? DequantizeValue(Source.BaseValue, IsQuantized, Scale) : Target.CurrentValue;
+
+		FValueLimits& Limits = Target.ValueLimits;
+		Limits.UseMinBaseValue = (Source.Flags & UseMinBaseValue) != 0;
+		Limits.UseMaxBaseValue = (Source.Flags & UseMaxBaseValue) != 0;
+		Limits.UseMinCurrentValue = (Source.Flags & UseMinCurrentValue) != 0;
+		Limits.UseMaxCurrentValue = (Source.Flags & UseMaxCurrentValue) != 0;
+		Limits.MinBaseValue = Limits.UseMinBaseValue ? BitsToFloat(Source.Limits[0]) : Limits.MinBaseValue;
+		Limits.MaxBaseValue = Limits.UseMaxBaseValue ? BitsToFloat(Source.Limits[1]) : Limits.MaxBaseValue;
+		Limits.MinCurrentValue = Limits.UseMinCurrentValue ? BitsToFloat(Source.Limits[2]) : Limits.MinCurrentValue;
+		Limits.MaxCurrentValue = Limits.UseMaxCurrentValue ? BitsToFloat(Source.Limits[3]) : Limits.MaxCurrentValue;
+	}
+
+	bool FFloatAttributeNetSerializer::IsEqual(FNetSerializationContext& Context, const FNetIsEqualArgs& Args)
+	{
+		if (Args.bStateIsQuantized)
+		{
+			const QuantizedType& Value0 = *reinterpret_cast<const QuantizedType*>(Args.Source0);
+			const QuantizedType& Value1 = *reinterpret_cast<const QuantizedType*>(Args.Source1);
+
+			return Value0.TagNetIndex == Value1.TagNetIndex &&
+				Value0.CurrentValue == Value1.CurrentValue &&
+				Value0.BaseValue == Value1.BaseValue &&
+				Value0.Flags == Value1.Flags &&
+				Value0.Precision == Value1.Precision &&
+				FMemory::Memcmp(Value0.Limits, Value1.Limits, sizeof(Value0.Limits)) == 0;
+		}
+
+		const SourceType& Value0 = *reinterpret_cast<const SourceType*>(Args.Source0);
+		const SourceType& Value1 = *reinterpret_cast<const SourceType*>(Args.Source1);
+		const FValueLimits& Limits0 = Value0.ValueLimits;
+		const FValueLimits& Limits1 = Value1.ValueLimits;
+
+		return Value0.AttributeTag == Value1.AttributeTag &&
+			Value0.CurrentValue == Value1.CurrentValue &&
+			Value0.BaseValue == Value1.BaseValue &&
+			Value0.NetPrecision == Value1.NetPrecision &&
+			Limits0.UseMinBaseValue == Limits1.UseMinBaseValue && Limits0.MinBaseValue == Limits1.MinBaseValue &&
+			Limits0.UseMaxBaseValue == Limits1.UseMaxBaseValue && Limits0.MaxBaseValue == Limits1.MaxBaseValue &&
+			Limits0.UseMinCurrentValue == Limits1.UseMinCurrentValue && Limits0.MinCurrentValue == Limits1.MinCurrentValue &&
+			Limits0.UseMaxCurrentValue == Limits1.UseMaxCurrentValue && Limits0.MaxCurrentValue == Limits1.MaxCurrentValue;
+	}
+
+	bool FFloatAttributeNetSerializer::Validate(FNetSerializationContext& Context, const FNetValidateArgs& Args)
+	{
+		const SourceType& Source = *reinterpret_cast<const SourceType*>(Args.Source);
+		return Source.NetPrecision <= EAttributeNetPrecision::Hundredth;
+	}
+
+	FFloatAttributeNetSerializer::FNetSerializerRegistryDelegates::~FNetSerializerRegistryDelegates()
+	{
+		UE_NET_UNREGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_FloatAttribute);
+	}
+
+	void FFloatAttributeNetSerializer::FNetSerializerRegistryDelegates::OnPreFreezeNetSerializerRegistry()
+	{
+		UE_NET_REGISTER_NETSERIALIZER_INFO(PropertyNetSerializerRegistry_NAME_FloatAttribute);
+	}
+}
+
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Iris/Serialization/NetSerializer.h"
+#include "FloatAttributeNetSerializer.generated.h"
+
+USTRUCT()
+struct FFloatAttributeNetSerializerConfig : public FNetSerializerConfig
+{
+	GENERATED_BODY()
+};
+
+namespace UE::Net
+{
+	/* Iris version of FFloatAttribute::NetSerialize. Sends exactly the same data so both replication systems behave the same. */
+	UE_NET_DECLARE_SERIALIZER(FFloatAttributeNetSerializer, SIMPLEGAMEPLAYABILITYSYSTEM_API);
+}
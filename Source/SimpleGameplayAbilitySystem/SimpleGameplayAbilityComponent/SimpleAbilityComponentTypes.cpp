@@ -1,16 +1,153 @@
 #include "SimpleAbilityComponentTypes.h"
 
-void FFloatAttribute::PreReplicatedRemove(const struct FFloatAttributeContainer& InArraySerializer)
+#include "FloatAttributeNetSerialization.h"
+#include "GameplayTagsManager.h"
+
+namespace SimpleAttributeNetSerialization
 {
-	InArraySerializer.OnFloatAttributeRemoved.ExecuteIfBound(*this);
+	void SerializeValue(FArchive& Ar, float& Value, const bool IsQuantized, const float Scale)
+	{
+		if (!IsQuantized)
+		{
+			Ar << Value;
+			return;
+		}
+
+		uint32 EncodedValue = Ar.IsSaving() ? EncodeQuantizedValue(Value, Scale) : 0;
+		Ar.SerializeIntPacked(EncodedValue);
+
+		if (Ar.IsLoading())
+		{
+			Value = DecodeQuantizedValue(EncodedValue, Scale);
+		}
+	}
 }
 
-void FFloatAttribute::PostReplicatedAdd(const struct FFloatAttributeContainer& InArraySerializer)
+bool FFloatAttribute::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
-	InArraySerializer.OnFloatAttributeAdded.ExecuteIfBound(*this);
+	using namespace SimpleAttributeNetSerialization;
+	
+	bOutSuccess = true;
+
+	UGameplayTagsManager& TagsManager = UGameplayTagsManager::Get();
+	uint32 TagNetIndex = Ar.IsSaving() ? TagsManager.GetNetIndexFromTag(AttributeTag) : 0;
+	Ar.SerializeIntPacked(TagNetIndex);
+
+	if (Ar.IsLoading())
+	{
+		AttributeTag = FGameplayTag::RequestGameplayTag(TagsManager.GetTagNameFromNetIndex(static_cast<FGameplayTagNetIndex>(TagNetIndex)), false);
+		AttributeName = AttributeTag.GetTagName();
+	}
+
+	uint8 Flags = Ar.IsSaving() ? MakeFlags(*this) : 0;
+
+	Ar.SerializeBits(&Flags, NumFlagBits);
+
+	if (Flags & Quantized)
+	{
+		uint8 Precision = static_cast<uint8>(NetPrecision);
+		Ar.SerializeBits(&Precision, NumPrecisionBits);
+		NetPrecision = static_cast<EAttributeNetPrecision>(Precision);
+	}
+	else if (Ar.IsLoading())
+	{
+		NetPrecision = EAttributeNetPrecision::Full;
+	}
+
+	const bool IsQuantized = (Flags & Quantized) != 0;
+	const float Scale = GetPrecisionScale(NetPrecision);
+
+	SerializeValue(Ar, CurrentValue, IsQuantized, Scale);
+
+	if (Flags & BaseValueDiffers)
+	{
+		SerializeValue(Ar, BaseValue, IsQuantized, Scale);
+	}
+	else if (Ar.IsLoading())
+	{
+		BaseValue = CurrentValue;
+	}
+
+	// Limits aren't quantized, rounding a limit could let values go past it on the client
+	ValueLimits.UseMinBaseValue = (Flags & UseMinBaseValue) != 0;
+	ValueLimits.UseMaxBaseValue = (Flags & UseMaxBaseValue) != 0;
+	ValueLimits.UseMinCurrentValue = (Flags & UseMinCurrentValue) != 0;
+	ValueLimits.UseMaxCurrentValue = (Flags & UseMaxCurrentValue) != 0;
+
+	if (ValueLimits.UseMinBaseValue)
+	{
+		Ar << ValueLimits.MinBaseValue;
+	}
+	
+	if (ValueLimits.UseMaxBaseValue)
+	{
+		Ar << ValueLimits.MaxBaseValue;
+	}
+	
+	if (ValueLimits.UseMinCurrentValue)
+	{
+		Ar << ValueLimits.MinCurrentValue;
+	}
+	
+	if (ValueLimits.UseMaxCurrentValue)
+	{
+		Ar << ValueLimits.MaxCurrentValue;
+	}
+
+	return true;
 }
 
-void FFloatAttribute::PostReplicatedChange(const struct FFloatAttributeContainer& InArraySerializer)
+bool FReplicatedEventBatchEntry::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
-	InArraySerializer.OnFloatAttributeChanged.ExecuteIfBound(*this);
+	bOutSuccess = true;
+
+	FSimpleNetID::SerializeCompactID(Ar, CompactEventID);
+
+	bool TagSuccess = true;
+	EventTag.NetSerialize(Ar, Map, TagSuccess);
+	bOutSuccess &= TagSuccess;
+	DomainTag.NetSerialize(Ar, Map, TagSuccess);
+	bOutSuccess &= TagSuccess;
+
+	bool PayloadSuccess = true;
+	Payload.NetSerialize(Ar, Map, PayloadSuccess);
+	bOutSuccess &= PayloadSuccess;
+
+	bOutSuccess &= Map->SerializeObject(Ar, UObject::StaticClass(), Sender);
+
+	uint8 Policy = static_cast<uint8>(ReplicationPolicy);
+	Ar << Policy;
+	ReplicationPolicy = static_cast<ESimpleEventReplicationPolicy>(Policy);
+
+	uint8 HasListenerFilter = ListenerFilter.Num() > 0 ? 1 : 0;
+	Ar.SerializeBits(&HasListenerFilter, 1);
+
+	if (!HasListenerFilter)
+	{
+		ListenerFilter.Reset();
+		return true;
+	}
+
+	uint32 ListenerFilterNum = ListenerFilter.Num();
+	Ar.SerializeIntPacked(ListenerFilterNum);
+
+	// Bigger filters are never batched so this can only be a malformed packet
+	if (Ar.IsLoading() && ListenerFilterNum > static_cast<uint32>(MaxListenerFilterNum))
+	{
+		Ar.SetError();
+		bOutSuccess = false;
+		return false;
+	}
+
+	if (Ar.IsLoading())
+	{
+		ListenerFilter.SetNum(ListenerFilterNum);
+	}
+
+	for (UObject*& Listener : ListenerFilter)
+	{
+		bOutSuccess &= Map->SerializeObject(Ar, UObject::StaticClass(), Listener);
+	}
+
+	return true;
 }
@@ -10,12 +10,14 @@
 #endif
 
 #include "Net/Serialization/FastArraySerializer.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleNetID.h"
 #include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/AttributeHandler/SimpleAttributeHandler.h"
 #include "SimpleAbilityComponentTypes.generated.h"
 
 
 /* Enums */
 
+class USimpleAttributeModifier;
 class USimpleGameplayAbility;
 class USimpleGameplayAbilityComponent;
 struct FFloatAttribute;
@@ -44,7 +46,53 @@ enum class ESimpleEventReplicationPolicy : uint8
 	 * This event will be sent to all connected clients.
 	 * Clients can send the event locally before the server sends the event.
 	 */
-	AllConnectedClientsPredicted
+	AllConnectedClientsPredicted,
+	/**
+	 * Same as ServerAndOwningClient but sent with unreliable RPCs.
+	 * Use for cosmetic events (e.g. UI pings) that can be dropped under heavy traffic.
+	 */
+	ServerAndOwningClientUnreliable,
+	/**
+	 * Same as AllConnectedClients but sent with unreliable RPCs.
+	 * Use for cosmetic events (e.g. hit sparks, footsteps) that can be dropped under heavy traffic.
+	 */
+	AllConnectedClientsUnreliable
+};
+
+UENUM(BlueprintType)
+enum class EAttributeReplicationScope : uint8
+{
+	/* The attribute is replicated to every client. */
+	Everyone,
+	/* The attribute is only replicated to the client that owns the ability component. */
+	OwnerOnly,
+	/* The attribute is only replicated to clients that don't own the ability component. */
+	SimulatedOnly,
+	/* The attribute is never replicated and only exists on the server. */
+	None
+};
+
+/* How precisely a float attribute's values are sent to clients. The server always keeps the exact value. */
+UENUM(BlueprintType)
+enum class EAttributeNetPrecision : uint8
+{
+	/* Values are sent as full 32 bit floats. */
+	Full,
+	/* Values are rounded to the nearest whole number. */
+	WholeNumber,
+	/* Values are rounded to 0.1 */
+	Tenth,
+	/* Values are rounded to 0.01 */
+	Hundredth
+};
+
+/* Who a replicated event RPC is sent to. Used internally by the ability component. */
+UENUM()
+enum class EReplicatedEventTarget : uint8
+{
+	Server,
+	OwningClient,
+	AllClients
 };
 
 UENUM(BlueprintType)
@@ -138,6 +186,54 @@ struct FValueLimits
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool UseMaxCurrentValue;
+
+	bool operator==(const FValueLimits& Other) const
+	{
+		return MinBaseValue == Other.MinBaseValue && MaxBaseValue == Other.MaxBaseValue &&
+			MinCurrentValue == Other.MinCurrentValue && MaxCurrentValue == Other.MaxCurrentValue &&
+			UseMinBaseValue == Other.UseMinBaseValue && UseMaxBaseValue == Other.UseMaxBaseValue &&
+			UseMinCurrentValue == Other.UseMinCurrentValue && UseMaxCurrentValue == Other.UseMaxCurrentValue;
+	}
+
+	bool operator!=(const FValueLimits& Other) const
+	{
+		return !(*this == Other);
+	}
+};
+
+/**
+ * Controls how often a float attribute is replicated. By default every change is replicated on the next net update.
+ * Use these to stop frequent tiny changes (e.g. regeneration ticks) from replicating every time.
+ */
+USTRUCT(BlueprintType)
+struct FAttributeReplicationSettings
+{
+	GENERATED_BODY()
+
+	/* The minimum time in seconds between two replications of this attribute. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MinReplicationInterval = 0.0f;
+
+	/* Changes smaller than this (compared to the last replicated value) wait for MaxReplicationDelay before replicating. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MinAbsoluteChange = 0.0f;
+
+	/* Same as MinAbsoluteChange but as a fraction of the last replicated value. e.g. 0.05 = 5% */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MinRelativeChange = 0.0f;
+
+	/* Changes that were held back are always replicated after this many seconds so clients end up with the correct value. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0"))
+	float MaxReplicationDelay = 1.0f;
+
+	/* If true, reaching a value limit or crossing zero is replicated immediately, ignoring the settings above. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool AlwaysReplicateImportantChanges = true;
+
+	bool IsThrottled() const
+	{
+		return MinReplicationInterval > 0.0f || MinAbsoluteChange > 0.0f || MinRelativeChange > 0.0f;
+	}
 };
 
 USTRUCT(BlueprintType)
@@ -180,10 +276,30 @@ struct FStructAttributeModification
 	FInstancedStruct OldValue;
 };
 
+/**
+ * Payload of the AttributesChanged event. Sent on clients once per replication update, after the events of the
+ * individual attributes, so code that reacts to many attributes (e.g. a stats screen) only has to update once.
+ */
+USTRUCT(BlueprintType)
+struct FAttributesChangedPayload
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	USimpleGameplayAbilityComponent* AttributeOwner = nullptr;
+
+	/* Every float and struct attribute that was added, changed or removed in this update. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FGameplayTagContainer AttributeTags;
+};
+
 // Float attribute 
-DECLARE_DELEGATE_OneParam(FOnFloatAttributeAdded, const FFloatAttribute&);
-DECLARE_DELEGATE_OneParam(FOnFloatAttributeChanged, const FFloatAttribute&);
-DECLARE_DELEGATE_OneParam(FOnFloatAttributeRemoved, const FFloatAttribute&);
+struct FFloatAttributeContainer;
+
+// Replication callbacks get every index that was added/changed/removed in the update at once
+DECLARE_DELEGATE_TwoParams(FOnFloatAttributesAdded, FFloatAttributeContainer&, const TArrayView<int32>&);
+DECLARE_DELEGATE_TwoParams(FOnFloatAttributesChanged, FFloatAttributeContainer&, const TArrayView<int32>&);
+DECLARE_DELEGATE_TwoParams(FOnFloatAttributesRemoved, const FFloatAttributeContainer&, const TArrayView<int32>&);
 
 USTRUCT(BlueprintType)
 struct FFloatAttribute : public FFastArraySerializerItem
@@ -205,9 +321,41 @@ struct FFloatAttribute : public FFastArraySerializerItem
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	FValueLimits ValueLimits;
 
-	void PreReplicatedRemove(const struct FFloatAttributeContainer& InArraySerializer);
-	void PostReplicatedAdd(const struct FFloatAttributeContainer& InArraySerializer);
-	void PostReplicatedChange(const struct FFloatAttributeContainer& InArraySerializer);
+	/* Which clients receive this attribute. Can't be changed after the attribute is added unless it's added again. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, NotReplicated)
+	EAttributeReplicationScope ReplicationScope = EAttributeReplicationScope::Everyone;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, NotReplicated)
+	FAttributeReplicationSettings ReplicationSettings;
+
+	/* Rounding values before they're sent makes them much smaller on the wire e.g. health at 0.1 precision usually fits in 2 bytes. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, NotReplicated)
+	EAttributeNetPrecision NetPrecision = EAttributeNetPrecision::Full;
+
+	/* Server only. The values clients were last sent, used to decide when to replicate again. */
+	float LastReplicatedBaseValue = 0.0f;
+	float LastReplicatedCurrentValue = 0.0f;
+	FValueLimits LastReplicatedValueLimits;
+	double LastReplicatedTime = -UE_BIG_NUMBER;
+
+	/* Client only. The values from the latest update, the next update is compared against them for change events. */
+	float ReceivedBaseValue = 0.0f;
+	float ReceivedCurrentValue = 0.0f;
+	FValueLimits ReceivedValueLimits;
+
+	void StoreReceivedValues()
+	{
+		ReceivedBaseValue = BaseValue;
+		ReceivedCurrentValue = CurrentValue;
+		ReceivedValueLimits = ValueLimits;
+	}
+
+	/**
+	 * AttributeName isn't sent, clients use the tag name instead. The tag is sent as its net index so the client and
+	 * server need the same gameplay tags. Only the value limits that are in use are sent and BaseValue is skipped when it
+	 * matches CurrentValue.
+	 */
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
 	
 	bool operator==(const FFloatAttribute& Other) const
 	{
@@ -220,6 +368,15 @@ struct FFloatAttribute : public FFastArraySerializerItem
 	}
 };
 
+template<>
+struct TStructOpsTypeTraits<FFloatAttribute> : public TStructOpsTypeTraitsBase2<FFloatAttribute>
+{
+	enum 
+	{
+		WithNetSerializer = true,
+	};
+};
+
 USTRUCT()
 struct FFloatAttributeContainer : public FFastArraySerializer
 {
@@ -228,9 +385,24 @@ struct FFloatAttributeContainer : public FFastArraySerializer
 	UPROPERTY(EditAnywhere, meta = (TitleProperty = "AttributeName"))
 	TArray<FFloatAttribute> Attributes;
 
-	FOnFloatAttributeAdded   OnFloatAttributeAdded;
-	FOnFloatAttributeChanged OnFloatAttributeChanged;
-	FOnFloatAttributeRemoved OnFloatAttributeRemoved;
+	FOnFloatAttributesAdded   OnFloatAttributesAdded;
+	FOnFloatAttributesChanged OnFloatAttributesChanged;
+	FOnFloatAttributesRemoved OnFloatAttributesRemoved;
+
+	void PostReplicatedAdd(const TArrayView< int32 >& AddedIndices, int32 FinalSize)
+	{
+		OnFloatAttributesAdded.ExecuteIfBound(*this, AddedIndices);
+	}
+	
+	void PostReplicatedChange(const TArrayView< int32 >& ChangedIndices, int32 FinalSize)
+	{
+		OnFloatAttributesChanged.ExecuteIfBound(*this, ChangedIndices);
+	}
+
+	void PreReplicatedRemove (const TArrayView< int32 >& RemovedIndices, int32 FinalSize)
+	{
+		OnFloatAttributesRemoved.ExecuteIfBound(*this, RemovedIndices);
+	}
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo & DeltaParms)
 	{
@@ -272,9 +444,20 @@ struct FStructAttribute : public FFastArraySerializerItem
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly)
 	TSubclassOf<USimpleAttributeHandler> StructAttributeHandler;
 
+	/* Which clients receive this attribute. Can't be changed after the attribute is added unless it's added again. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, NotReplicated)
+	EAttributeReplicationScope ReplicationScope = EAttributeReplicationScope::Everyone;
+
 	// Add this delegate to listen for value changes
 	FOnStructAttributeValueChanged OnValueChanged;
 
+	/**
+	 * On clients, the value received before the latest update. Replication overwrites AttributeValue in place, so the
+	 * change callback takes this for the changed event and then stores the new value here. Only kept while something
+	 * listens for the attribute's changed event.
+	 */
+	FInstancedStruct PreviousAttributeValue;
+
 	bool operator==(const FStructAttribute& Other) const
 	{
 		return AttributeTag == Other.AttributeTag;
@@ -286,9 +469,12 @@ struct FStructAttribute : public FFastArraySerializerItem
 	}
 };
 
-DECLARE_DELEGATE_OneParam(FOnStructAttributeAdded, const FStructAttribute&);
-DECLARE_DELEGATE_OneParam(FOnStructAttributeChanged, const FStructAttribute&);
-DECLARE_DELEGATE_OneParam(FOnStructAttributeRemoved, const FStructAttribute&);
+struct FStructAttributeContainer;
+
+// Not const, the receiver updates the previous values of the received items
+DECLARE_DELEGATE_TwoParams(FOnStructAttributesAdded, FStructAttributeContainer&, const TArrayView<int32>&);
+DECLARE_DELEGATE_TwoParams(FOnStructAttributesChanged, FStructAttributeContainer&, const TArrayView<int32>&);
+DECLARE_DELEGATE_TwoParams(FOnStructAttributesRemoved, FStructAttributeContainer&, const TArrayView<int32>&);
 
 USTRUCT()
 struct FStructAttributeContainer : public FFastArraySerializer
@@ -298,41 +484,23 @@ struct FStructAttributeContainer : public FFastArraySerializer
 	UPROPERTY(EditAnywhere, meta = (TitleProperty = "AttributeName"))
 	TArray<FStructAttribute> Attributes;
 
-	FOnStructAttributeAdded   OnStructAttributeAdded;
-	FOnStructAttributeChanged OnStructAttributeChanged;
-	FOnStructAttributeRemoved OnStructAttributeRemoved;
+	FOnStructAttributesAdded   OnStructAttributesAdded;
+	FOnStructAttributesChanged OnStructAttributesChanged;
+	FOnStructAttributesRemoved OnStructAttributesRemoved;
 	
 	void PostReplicatedAdd(const TArrayView< int32 >& AddedIndices, int32 FinalSize)
 	{
-		if (OnStructAttributeAdded.IsBound())
-		{
-			for (const int32 AddedIndex : AddedIndices)
-			{
-				OnStructAttributeAdded.Execute(Attributes[AddedIndex]);
-			}
-		}
+		OnStructAttributesAdded.ExecuteIfBound(*this, AddedIndices);
 	}
 	
 	void PostReplicatedChange(const TArrayView< int32 >& ChangedIndices, int32 FinalSize)
 	{
-		if (OnStructAttributeChanged.IsBound())
-		{
-			for (const int32 ChangedIndex : ChangedIndices)
-			{
-				OnStructAttributeChanged.Execute(Attributes[ChangedIndex]);
-			}
-		}
+		OnStructAttributesChanged.ExecuteIfBound(*this, ChangedIndices);
 	}
 
 	void PreReplicatedRemove (const TArrayView< int32 >& RemovedIndices, int32 FinalSize)
 	{
-		if (OnStructAttributeRemoved.IsBound())
-		{
-			for (const int32 RemovedIndex : RemovedIndices)
-			{
-				OnStructAttributeRemoved.Execute(Attributes[RemovedIndex]);
-			}
-		}
+		OnStructAttributesRemoved.ExecuteIfBound(*this, RemovedIndices);
 	}
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo & DeltaParms)
@@ -372,9 +540,11 @@ struct FGameplayTagCounter : public FFastArraySerializerItem
 	}
 };
 
-DECLARE_DELEGATE_OneParam(FOnGameplayTagCounterAdded, const FGameplayTagCounter&);
-DECLARE_DELEGATE_OneParam(FOnGameplayTagCounterChanged, const FGameplayTagCounter&);
-DECLARE_DELEGATE_OneParam(FOnGameplayTagCounterRemoved, const FGameplayTagCounter&);
+struct FGameplayTagCounterContainer;
+
+DECLARE_DELEGATE_TwoParams(FOnGameplayTagCountersAdded, const FGameplayTagCounterContainer&, const TArrayView<int32>&);
+DECLARE_DELEGATE_TwoParams(FOnGameplayTagCountersChanged, const FGameplayTagCounterContainer&, const TArrayView<int32>&);
+DECLARE_DELEGATE_TwoParams(FOnGameplayTagCountersRemoved, const FGameplayTagCounterContainer&, const TArrayView<int32>&);
 
 USTRUCT()
 struct FGameplayTagCounterContainer : public FFastArraySerializer
@@ -384,51 +554,139 @@ struct FGameplayTagCounterContainer : public FFastArraySerializer
 	UPROPERTY(EditAnywhere, meta = (TitleProperty = "GameplayTag"))
 	TArray<FGameplayTagCounter> Tags;
 
-	FOnGameplayTagCounterAdded   OnGameplayTagCounterAdded;
-	FOnGameplayTagCounterChanged OnGameplayTagCounterChanged;
-	FOnGameplayTagCounterRemoved OnGameplayTagCounterRemoved;
+	FOnGameplayTagCountersAdded   OnGameplayTagCountersAdded;
+	FOnGameplayTagCountersChanged OnGameplayTagCountersChanged;
+	FOnGameplayTagCountersRemoved OnGameplayTagCountersRemoved;
 	
 	void PostReplicatedAdd(const TArrayView< int32 >& AddedIndices, int32 FinalSize)
 	{
-		if (OnGameplayTagCounterAdded.IsBound())
+		OnGameplayTagCountersAdded.ExecuteIfBound(*this, AddedIndices);
+	}
+	
+	void PostReplicatedChange(const TArrayView< int32 >& ChangedIndices, int32 FinalSize)
+	{
+		OnGameplayTagCountersChanged.ExecuteIfBound(*this, ChangedIndices);
+	}
+
+	void PreReplicatedRemove (const TArrayView< int32 >& RemovedIndices, int32 FinalSize)
+	{
+		OnGameplayTagCountersRemoved.ExecuteIfBound(*this, RemovedIndices);
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo & DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FGameplayTagCounter, FGameplayTagCounterContainer>(Tags, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGameplayTagCounterContainer> : public TStructOpsTypeTraitsBase2<FGameplayTagCounterContainer>
+{
+	enum 
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+ * A running cooldown. Cooldowns are keyed by CooldownTag if the ability has one (so abilities can share a cooldown),
+ * otherwise by AbilityClass. Only the end time and total duration are replicated.
+ */
+USTRUCT(BlueprintType)
+struct FAbilityCooldown : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	TSubclassOf<USimpleGameplayAbility> AbilityClass;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	FGameplayTag CooldownTag;
+
+	// Server time at which the cooldown ends
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	double CooldownEndTime = 0.0;
+
+	// Total length of the cooldown including any modifications made while it was running. Useful for UI progress bars.
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+	float CooldownDuration = 0.0f;
+
+	// Handle of the expiry timer in USimpleTimerSubsystem. Not replicated.
+	uint64 ExpiryTimerHandle = 0;
+
+	bool MatchesKey(const TSubclassOf<USimpleGameplayAbility> InAbilityClass, const FGameplayTag InCooldownTag) const
+	{
+		if (InCooldownTag.IsValid())
+		{
+			return CooldownTag.MatchesTagExact(InCooldownTag);
+		}
+
+		return !CooldownTag.IsValid() && AbilityClass == InAbilityClass;
+	}
+
+	bool operator==(const FAbilityCooldown& Other) const
+	{
+		return MatchesKey(Other.AbilityClass, Other.CooldownTag);
+	}
+};
+
+DECLARE_DELEGATE_OneParam(FOnAbilityCooldownAdded, const FAbilityCooldown&);
+DECLARE_DELEGATE_OneParam(FOnAbilityCooldownChanged, const FAbilityCooldown&);
+DECLARE_DELEGATE_OneParam(FOnAbilityCooldownRemoved, const FAbilityCooldown&);
+
+USTRUCT()
+struct FAbilityCooldownContainer : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere)
+	TArray<FAbilityCooldown> Cooldowns;
+
+	FOnAbilityCooldownAdded   OnAbilityCooldownAdded;
+	FOnAbilityCooldownChanged OnAbilityCooldownChanged;
+	FOnAbilityCooldownRemoved OnAbilityCooldownRemoved;
+	
+	void PostReplicatedAdd(const TArrayView< int32 >& AddedIndices, int32 FinalSize)
+	{
+		if (OnAbilityCooldownAdded.IsBound())
 		{
 			for (const int32 AddedIndex : AddedIndices)
 			{
-				OnGameplayTagCounterAdded.Execute(Tags[AddedIndex]);
+				OnAbilityCooldownAdded.Execute(Cooldowns[AddedIndex]);
 			}
 		}
 	}
 	
 	void PostReplicatedChange(const TArrayView< int32 >& ChangedIndices, int32 FinalSize)
 	{
-		if (OnGameplayTagCounterChanged.IsBound())
+		if (OnAbilityCooldownChanged.IsBound())
 		{
 			for (const int32 ChangedIndex : ChangedIndices)
 			{
-				OnGameplayTagCounterChanged.Execute(Tags[ChangedIndex]);
+				OnAbilityCooldownChanged.Execute(Cooldowns[ChangedIndex]);
 			}
 		}
 	}
 
 	void PreReplicatedRemove (const TArrayView< int32 >& RemovedIndices, int32 FinalSize)
 	{
-		if (OnGameplayTagCounterRemoved.IsBound())
+		if (OnAbilityCooldownRemoved.IsBound())
 		{
 			for (const int32 RemovedIndex : RemovedIndices)
 			{
-				OnGameplayTagCounterRemoved.Execute(Tags[RemovedIndex]);
+				OnAbilityCooldownRemoved.Execute(Cooldowns[RemovedIndex]);
 			}
 		}
 	}
 
 	bool NetDeltaSerialize(FNetDeltaSerializeInfo & DeltaParms)
 	{
-		return FFastArraySerializer::FastArrayDeltaSerialize<FGameplayTagCounter, FGameplayTagCounterContainer>(Tags, DeltaParms, *this);
+		return FFastArraySerializer::FastArrayDeltaSerialize<FAbilityCooldown, FAbilityCooldownContainer>(Cooldowns, DeltaParms, *this);
 	}
 };
 
 template<>
-struct TStructOpsTypeTraits<FGameplayTagCounterContainer> : public TStructOpsTypeTraitsBase2<FGameplayTagCounterContainer>
+struct TStructOpsTypeTraits<FAbilityCooldownContainer> : public TStructOpsTypeTraitsBase2<FAbilityCooldownContainer>
 {
 	enum 
 	{
@@ -436,6 +694,54 @@ struct TStructOpsTypeTraits<FGameplayTagCounterContainer> : public TStructOpsTyp
 	};
 };
 
+/**
+ * A replicated event queued by an ability component and sent together with other events in a single RPC.
+ * Uses the compact event ID instead of a full FGuid and skips the listener filter when it's empty.
+ */
+USTRUCT()
+struct FReplicatedEventBatchEntry
+{
+	GENERATED_BODY()
+
+	// Listener filters are meant for a handful of objects, events with bigger filters are sent with their own RPC
+	static constexpr int32 MaxListenerFilterNum = 64;
+
+	// See FSimpleNetID
+	UPROPERTY()
+	uint32 CompactEventID = 0;
+
+	UPROPERTY()
+	FGameplayTag EventTag;
+
+	UPROPERTY()
+	FGameplayTag DomainTag;
+
+	UPROPERTY()
+	FInstancedStruct Payload;
+
+	UPROPERTY()
+	UObject* Sender = nullptr;
+
+	UPROPERTY()
+	ESimpleEventReplicationPolicy ReplicationPolicy = ESimpleEventReplicationPolicy::NoReplication;
+
+	UPROPERTY()
+	TArray<UObject*> ListenerFilter;
+
+	FGuid GetEventID() const { return FSimpleNetID::FromCompactID(CompactEventID); }
+	
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FReplicatedEventBatchEntry> : public TStructOpsTypeTraitsBase2<FReplicatedEventBatchEntry>
+{
+	enum 
+	{
+		WithNetSerializer = true,
+	};
+};
+
 UENUM(BlueprintType)
 enum class EFlowControl : uint8
 {
@@ -483,4 +789,26 @@ struct FAbilityActivationEvent
 	
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float ActivationTimeStamp;
+};
+
+USTRUCT(BlueprintType)
+struct FAbilityCooldownEndedEvent
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TSubclassOf<USimpleGameplayAbility> AbilityClass;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	FGameplayTag CooldownTag;
+};
+
+/* A list of attribute modifiers stored as a map value, e.g. the pooled modifiers of one class. */
+USTRUCT()
+struct FAttributeModifierList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<USimpleAttributeModifier*> Modifiers;
 };
\ No newline at end of file
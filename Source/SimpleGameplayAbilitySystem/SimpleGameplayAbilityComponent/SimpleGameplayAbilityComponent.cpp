@@ -2,6 +2,8 @@
 
 #include "GameFramework/GameStateBase.h"
 #include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Engine/NetDriver.h"
 #include "SimpleGameplayAbilitySystem/DataAssets/AbilitySet/AbilitySet.h"
 #include "SimpleGameplayAbilitySystem/DataAssets/AttributeSet/AttributeSet.h"
 #include "SimpleGameplayAbilitySystem/DefaultTags/DefaultTags.h"
@@ -11,11 +13,70 @@
 #include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubSystem.h"
 #include "SimpleGameplayAbilitySystem/DataAssets/AbilityOverrideSet/AbilityOverrideSet.h"
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAttributeModifier/SimpleAttributeModifier.h"
+#include "SimpleGameplayAbilitySystem/SimpleTimerSubsystem/SimpleTimerSubsystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleNetworkClock/SimpleNetworkClockComponent.h"
+#include "SimpleGameplayAbilitySystem/SimpleEventRelevancy/SimpleEventRelayComponent.h"
+#include "SimpleGameplayAbilitySystem/SimpleEventRelevancy/SimpleEventRelevancyPolicy.h"
+#include "GameFramework/PlayerController.h"
+#include "UObject/ObjectKey.h"
 
 class USimpleEventSubsystem;
 
 using enum EAbilityStatus;
 
+DECLARE_STATS_GROUP(TEXT("SimpleGAS"), STATGROUP_SimpleGAS, STATCAT_Advanced);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Components Using Idle Dormancy"), STAT_SimpleGAS_IdleDormancyComponents, STATGROUP_SimpleGAS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Idle Dormant Components"), STAT_SimpleGAS_IdleDormantComponents, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Relayed Event RPCs"), STAT_SimpleGAS_RelayedEventRPCs, STATGROUP_SimpleGAS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Culled Event RPCs"), STAT_SimpleGAS_CulledEventRPCs, STATGROUP_SimpleGAS);
+
+// Per relevancy policy totals for events sent with RelayRelevantEvent, reported by SimpleGAS.EventRelevancyReport.
+// Only RPC counts are tracked, not payload bytes.
+struct FEventRelevancyStats
+{
+	int32 Events = 0;
+	int32 SentRPCs = 0;
+	int32 CulledRPCs = 0;
+	// Relevant clients that didn't get the event because their PlayerController has no relay
+	int32 SkippedRPCs = 0;
+};
+
+// Kept per world so PIE servers and clients running in the same process don't mix their totals
+static TMap<TObjectKey<UWorld>, TMap<FName, FEventRelevancyStats>> EventRelevancyStats;
+
+static FAutoConsoleCommand EventRelevancyReportCommand(
+	TEXT("SimpleGAS.EventRelevancyReport"),
+	TEXT("Logs how many event RPCs each relevancy policy sent and culled compared to multicasting, per world. Pass 'reset' to clear the totals."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		if (Args.Num() > 0 && Args[0] == TEXT("reset"))
+		{
+			EventRelevancyStats.Reset();
+			return;
+		}
+
+		for (auto WorldIt = EventRelevancyStats.CreateIterator(); WorldIt; ++WorldIt)
+		{
+			const UWorld* World = WorldIt.Key().ResolveObjectPtr();
+
+			if (!World)
+			{
+				WorldIt.RemoveCurrent();
+				continue;
+			}
+			
+			for (const TPair<FName, FEventRelevancyStats>& PolicyStats : WorldIt.Value())
+			{
+				const FEventRelevancyStats& Stats = PolicyStats.Value;
+				const int32 MulticastRPCs = Stats.SentRPCs + Stats.CulledRPCs + Stats.SkippedRPCs;
+				const float CulledPercent = MulticastRPCs > 0 ? 100.0f * Stats.CulledRPCs / MulticastRPCs : 0.0f;
+
+				UE_LOG(LogSimpleGAS, Log, TEXT("%s %s: %d events, %d RPCs sent, %d RPCs culled (%.1f%%), %d RPCs skipped because the client had no relay"),
+					*World->GetName(), *PolicyStats.Key.ToString(), Stats.Events, Stats.SentRPCs, Stats.CulledRPCs, CulledPercent, Stats.SkippedRPCs);
+			}
+		}
+	}));
+
 USimpleGameplayAbilityComponent::USimpleGameplayAbilityComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
@@ -45,6 +106,7 @@ void USimpleGameplayAbilityComponent::BeginPlay()
 		// For abilities granted directly through the editor
 		for (const TSubclassOf<USimpleGameplayAbility> AbilityClass : GrantedAbilities)
 		{
+			AddActivatableAbilityClass(AbilityClass);
 			USimpleGameplayAbility::OnGrantedStatic(AbilityClass, this);
 		}
 		
@@ -90,6 +152,13 @@ void USimpleGameplayAbilityComponent::BeginPlay()
 			}
 		}
 
+		if (UseIdleNetDormancy && GetOwner())
+		{
+			IsTrackingIdleDormancy = true;
+			INC_DWORD_STAT(STAT_SimpleGAS_IdleDormancyComponents);
+			NotifyReplicatedStateChanged();
+		}
+
 		return;
 	}
 
@@ -102,28 +171,48 @@ void USimpleGameplayAbilityComponent::BeginPlay()
 	AuthorityAttributeStates.OnAbilityStateChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnStateChanged);
 	AuthorityAttributeStates.OnAbilityStateRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnStateRemoved);
 
-	AuthorityFloatAttributes.OnFloatAttributeAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnFloatAttributeAdded);
-	AuthorityFloatAttributes.OnFloatAttributeChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnFloatAttributeChanged);
-	AuthorityFloatAttributes.OnFloatAttributeRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnFloatAttributeRemoved);
+	AuthorityAbilityStatePayloads.OnAbilityStatePayloadAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnAbilityStatePayloadAdded);
+	AuthorityAbilityStatePayloads.OnAbilityStatePayloadChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnAbilityStatePayloadChanged);
+
+	AuthorityAttributeStatePayloads.OnAbilityStatePayloadAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnAttributeStatePayloadAdded);
+	AuthorityAttributeStatePayloads.OnAbilityStatePayloadChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnAttributeStatePayloadChanged);
+
+	// Clients only ever receive the containers for their replication scope, but they're all read as one set of attributes
+	for (FFloatAttributeContainer* Container : GetAuthorityFloatAttributeContainers())
+	{
+		Container->OnFloatAttributesAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnFloatAttributesAdded);
+		Container->OnFloatAttributesChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnFloatAttributesChanged);
+		Container->OnFloatAttributesRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnFloatAttributesRemoved);
+	}
 
-	AuthorityStructAttributes.OnStructAttributeAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnStructAttributeAdded);
-	AuthorityStructAttributes.OnStructAttributeChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnStructAttributeChanged);
-	AuthorityStructAttributes.OnStructAttributeRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnStructAttributeRemoved);
+	for (FStructAttributeContainer* Container : GetAuthorityStructAttributeContainers())
+	{
+		Container->OnStructAttributesAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnStructAttributesAdded);
+		Container->OnStructAttributesChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnStructAttributesChanged);
+		Container->OnStructAttributesRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnStructAttributesRemoved);
+	}
 
-	AuthorityGameplayTags.OnGameplayTagCounterAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnGameplayTagAdded);
-	AuthorityGameplayTags.OnGameplayTagCounterChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnGameplayTagChanged);
-	AuthorityGameplayTags.OnGameplayTagCounterRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnGameplayTagRemoved);
+	AuthorityGameplayTags.OnGameplayTagCountersAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnGameplayTagsAdded);
+	AuthorityGameplayTags.OnGameplayTagCountersChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnGameplayTagsChanged);
+	AuthorityGameplayTags.OnGameplayTagCountersRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnGameplayTagsRemoved);
 
-	LocalFloatAttributes = AuthorityFloatAttributes.Attributes;
-	LocalStructAttributes = AuthorityStructAttributes.Attributes;
+	AuthorityAbilityCooldowns.OnAbilityCooldownAdded.BindUObject(this, &USimpleGameplayAbilityComponent::OnAbilityCooldownAdded);
+	AuthorityAbilityCooldowns.OnAbilityCooldownChanged.BindUObject(this, &USimpleGameplayAbilityComponent::OnAbilityCooldownChanged);
+	AuthorityAbilityCooldowns.OnAbilityCooldownRemoved.BindUObject(this, &USimpleGameplayAbilityComponent::OnAbilityCooldownRemoved);
 
-	LocalGameplayTags = AuthorityGameplayTags.Tags;
+	// Cooldowns need their expiry timers scheduled, so we add them one by one instead of copying the array
+	for (const FAbilityCooldown& Cooldown : AuthorityAbilityCooldowns.Cooldowns)
+	{
+		OnAbilityCooldownAdded(Cooldown);
+	}
 }
 
 void USimpleGameplayAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Clean up attribute modifiers
-	for (USimpleAttributeModifier* AttributeModifier : InstancedAttributes)
+	// Clean up attribute modifiers. Ending a modifier releases it from InstancedAttributes so we iterate over a copy.
+	const TArray<USimpleAttributeModifier*> AttributeModifiers = InstancedAttributes;
+
+	for (USimpleAttributeModifier* AttributeModifier : AttributeModifiers)
 	{
 		AttributeModifier->CleanUpAbility();
 	}
@@ -134,8 +223,51 @@ void USimpleGameplayAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlay
 		Ability->CleanUpAbility();
 	}
     
+	// Send anything that was queued this frame before the component goes away
+	FlushReplicatedEvents();
+
+	if (USimpleTimerSubsystem* TimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USimpleTimerSubsystem>() : nullptr)
+	{
+		TimerSubsystem->CancelTimer(PendingFloatAttributeTimerHandle);
+	}
+
+	PendingFloatAttributeTimerHandle = 0;
+
+	if (IsTrackingIdleDormancy)
+	{
+		if (IdleDormant)
+		{
+			DEC_DWORD_STAT(STAT_SimpleGAS_IdleDormantComponents);
+			IdleDormant = false;
+		}
+
+		if (USimpleTimerSubsystem* TimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USimpleTimerSubsystem>() : nullptr)
+		{
+			TimerSubsystem->CancelTimer(DormancyCheckTimerHandle);
+		}
+
+		DormancyCheckTimerHandle = 0;
+		IsTrackingIdleDormancy = false;
+		DEC_DWORD_STAT(STAT_SimpleGAS_IdleDormancyComponents);
+	}
+	
+	// Clean up cooldown timers
+	for (FAbilityCooldown& Cooldown : AuthorityAbilityCooldowns.Cooldowns)
+	{
+		CancelCooldownExpiry(Cooldown);
+	}
+
+	for (FAbilityCooldown& Cooldown : LocalAbilityCooldowns)
+	{
+		CancelCooldownExpiry(Cooldown);
+	}
+    
 	// Clear collections
 	InstancedAttributes.Empty();
+	AttributeModifierPools.Empty();
+	EndedModifierStateIDs.Empty();
+	ActiveModifiersByClass.Empty();
+	ActiveModifiersByTag.Empty();
 	InstancedAbilities.Empty();
     
 	// Unsubscribe from events
@@ -147,6 +279,53 @@ void USimpleGameplayAbilityComponent::EndPlay(const EEndPlayReason::Type EndPlay
 	Super::EndPlay(EndPlayReason);
 }
 
+void USimpleGameplayAbilityComponent::PostRepNotifies()
+{
+	Super::PostRepNotifies();
+
+	// An item that moved to a container with a different replication scope is still found, so it wasn't really removed
+	for (const FGameplayTag& AttributeTag : PendingRemovedFloatAttributeTags)
+	{
+		if (!GetFloatAttribute(AttributeTag))
+		{
+			SendEvent(FDefaultTags::FloatAttributeRemoved(), AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+		}
+	}
+
+	for (const FGameplayTag& AttributeTag : PendingRemovedStructAttributeTags)
+	{
+		if (!GetStructAttribute(AttributeTag))
+		{
+			SendEvent(FDefaultTags::StructAttributeRemoved(), AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+		}
+	}
+
+	for (const FGameplayTag& Tag : PendingRemovedGameplayTags)
+	{
+		if (!HasGameplayTag(Tag))
+		{
+			SendEvent(FDefaultTags::GameplayTagRemoved(), Tag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
+		}
+	}
+
+	PendingRemovedFloatAttributeTags.Reset();
+	PendingRemovedStructAttributeTags.Reset();
+	PendingRemovedGameplayTags.Reset();
+
+	// The attribute containers have all applied their changes by now, so listeners get one event for the whole update
+	if (PendingChangedAttributeTags.IsEmpty())
+	{
+		return;
+	}
+
+	FAttributesChangedPayload Payload;
+	Payload.AttributeOwner = this;
+	Payload.AttributeTags = MoveTemp(PendingChangedAttributeTags);
+	PendingChangedAttributeTags.Reset();
+
+	SendEvent(FDefaultTags::AttributesChanged(), FDefaultTags::LocalAttributeDomain(), FInstancedStruct::Make(Payload), this, {}, ESimpleEventReplicationPolicy::NoReplication);
+}
+
 /* Ability Functions */
 
 bool USimpleGameplayAbilityComponent::ActivateAbility(
@@ -154,7 +333,7 @@ bool USimpleGameplayAbilityComponent::ActivateAbility(
 	const FInstancedStruct AbilityContext,
 	FGuid& AbilityID, const bool OverrideActivationPolicy, const EAbilityActivationPolicy ActivationPolicyOverride)
 {
-	AbilityID = FGuid::NewGuid();
+	AbilityID = MakeNetID();
 	return ActivateAbilityWithID(AbilityID, AbilityClass, AbilityContext, OverrideActivationPolicy, ActivationPolicyOverride);
 }
 
@@ -167,8 +346,93 @@ bool USimpleGameplayAbilityComponent::ActivateAbilityWithID(
 {
 	const EAbilityActivationPolicy ActivationPolicy = OverrideActivationPolicy ? ActivationPolicyOverride : AbilityClass.GetDefaultObject()->ActivationPolicy;
 	
+	// Clients use the same prefixed ID the server will, see FSimpleNetID::ToClientID
+	const FGuid NetAbilityID = HasAuthority() ? AbilityID : FSimpleNetID::ToClientID(AbilityID);
+	return ActivateAbilityWithPolicy(NetAbilityID, AbilityClass, AbilityContext, ActivationPolicy, GetCachedServerTime());
+}
+
+int32 USimpleGameplayAbilityComponent::ActivateAbilities(const TArray<FSimpleAbilityActivationRequest>& Requests, TArray<FGuid>& AbilityIDs)
+{
+	AbilityIDs.Reset(Requests.Num());
+	
+	FSimpleAbilityActivationBatch ServerRequests;
+	const float ActivationTime = GetCachedServerTime();
+	int32 ActivatedAbilityCount = 0;
+
+	for (const FSimpleAbilityActivationRequest& Request : Requests)
+	{
+		// Clients use the same prefixed ID the server will, see FSimpleNetID::ToClientID
+		const FGuid AbilityID = !Request.AbilityID.IsValid() ? MakeNetID() : HasAuthority() ? Request.AbilityID : FSimpleNetID::ToClientID(Request.AbilityID);
+		AbilityIDs.Add(AbilityID);
+
+		if (!Request.AbilityClass)
+		{
+			SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ActivateAbilities]: AbilityClass is null!"));
+			continue;
+		}
+
+		const EAbilityActivationPolicy ActivationPolicy = Request.OverrideActivationPolicy ? Request.ActivationPolicyOverride : Request.AbilityClass.GetDefaultObject()->ActivationPolicy;
+		
+		if (ActivateAbilityWithPolicy(AbilityID, Request.AbilityClass, Request.AbilityContext, ActivationPolicy, ActivationTime, &ServerRequests))
+		{
+			ActivatedAbilityCount++;
+		}
+	}
+
+	if (ServerRequests.CompactRequests.Num() > 0)
+	{
+		ServerActivateAbilitiesCompact(ServerRequests.CompactRequests, FSimpleAbilityActivationNetRequest::QuantizeActivationTime(ActivationTime));
+	}
+
+	if (ServerRequests.Requests.Num() > 0)
+	{
+		ServerActivateAbilities(ServerRequests.Requests, ActivationTime);
+	}
+
+	return ActivatedAbilityCount;
+}
+
+bool USimpleGameplayAbilityComponent::ActivateAbilityWithPolicy(
+	const FGuid AbilityID,
+	TSubclassOf<USimpleGameplayAbility> AbilityClass,
+	const FInstancedStruct& AbilityContext,
+	const EAbilityActivationPolicy ActivationPolicy,
+	const float ActivationTime,
+	FSimpleAbilityActivationBatch* ServerRequestBatch)
+{
 	const bool IsClient = GetNetMode() == NM_Client && !HasAuthority();
-	const float ActivationTime = GetServerTime();
+
+	// Batched activations collect their server requests so they can be sent in a single RPC
+	auto RequestServerActivation = [&]()
+	{
+		FSimpleAbilityActivationNetRequest CompactRequest;
+		const bool UseCompactRequest = MakeActivationNetRequest(AbilityID, AbilityClass, AbilityContext, ActivationPolicy, CompactRequest);
+
+		if (!ServerRequestBatch)
+		{
+			if (UseCompactRequest)
+			{
+				ServerActivateAbilityCompact(CompactRequest, FSimpleAbilityActivationNetRequest::QuantizeActivationTime(ActivationTime));
+				return;
+			}
+			
+			ServerActivateAbility(AbilityID, AbilityClass, AbilityContext, ActivationPolicy, ActivationTime);
+			return;
+		}
+
+		if (UseCompactRequest)
+		{
+			ServerRequestBatch->CompactRequests.Add(MoveTemp(CompactRequest));
+			return;
+		}
+
+		FSimpleAbilityActivationRequest& ServerRequest = ServerRequestBatch->Requests.AddDefaulted_GetRef();
+		ServerRequest.AbilityClass = AbilityClass;
+		ServerRequest.AbilityContext = AbilityContext;
+		ServerRequest.AbilityID = AbilityID;
+		ServerRequest.OverrideActivationPolicy = true;
+		ServerRequest.ActivationPolicyOverride = ActivationPolicy;
+	};
 
 	switch (ActivationPolicy)
 	{
@@ -186,7 +450,7 @@ bool USimpleGameplayAbilityComponent::ActivateAbilityWithID(
 		case EAbilityActivationPolicy::ServerInitiatedFromClient:
 			if (IsClient)
 			{
-				ServerActivateAbility(AbilityID, AbilityClass, AbilityContext, ActivationPolicy, ActivationTime);
+				RequestServerActivation();
 				return true;
 			}
 
@@ -195,7 +459,7 @@ bool USimpleGameplayAbilityComponent::ActivateAbilityWithID(
 		case EAbilityActivationPolicy::ClientPredicted:
 			if (IsClient)
 			{
-				ServerActivateAbility(AbilityID, AbilityClass, AbilityContext, ActivationPolicy, ActivationTime);
+				RequestServerActivation();
 			}
 		
 			return ActivateAbilityInternal(AbilityID, AbilityClass, AbilityContext, ActivationPolicy, true, ActivationTime);
@@ -237,18 +501,11 @@ bool USimpleGameplayAbilityComponent::ActivateAbilityInternal(
 	}
 
 	// Check if the ability is on cooldown
-	if (LastActivatedAbilityTimeStamps.Contains(AbilityClass))
+	if (IsAbilityOnCooldown(AbilityClass))
 	{
-		const float LastActivatedTime = LastActivatedAbilityTimeStamps[AbilityClass];
-		const float Cooldown = AbilityClass.GetDefaultObject()->Cooldown;
-
-		if (LastActivatedTime + Cooldown > GetServerTime())
-		{
-			SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::ActivateAbilityInternal]: Failed to activate ability %s because it is on cooldown."), *AbilityClass->GetName()));
-			return false;
-		}
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::ActivateAbilityInternal]: Failed to activate ability %s because it is on cooldown."), *AbilityClass->GetName()));
+		return false;
 	}
-	
 
 	CreateAbilityState(AbilityID, ActivationPolicy, AbilityClass, AbilityContext, HasAuthority(), ActivationTime);
 	
@@ -270,14 +527,14 @@ bool USimpleGameplayAbilityComponent::ActivateAbilityInternal(
 
 	if (WasActivated)
 	{
-		LastActivatedAbilityTimeStamps.Add(AbilityClass, GetServerTime());
+		StartAbilityCooldown(AbilityClass);
 
 		FAbilityActivationEvent ActivationEvent;
 		ActivationEvent.AbilityID = AbilityID;
 		ActivationEvent.AbilityClass = AbilityClass;
 		ActivationEvent.AbilityContext = AbilityContext;
 		ActivationEvent.WasActivatedSuccessfully = WasActivated;
-		ActivationEvent.ActivationTimeStamp = GetServerTime();
+		ActivationEvent.ActivationTimeStamp = GetCachedServerTime();
 		
 		const FGameplayTag DomainTag = HasAuthority() ? FDefaultTags::AuthorityAbilityDomain() : FDefaultTags::LocalAbilityDomain();
 		SendEvent(FDefaultTags::AbilityActivated(), DomainTag, FInstancedStruct::Make(ActivationEvent), this, {}, ESimpleEventReplicationPolicy::NoReplication);
@@ -295,7 +552,95 @@ void USimpleGameplayAbilityComponent::ServerActivateAbility_Implementation(const
 		return;
 	}
 	
-	ActivateAbilityInternal(AbilityID, AbilityClass, AbilityContext, ActivationPolicy, true, ActivationTime);
+	// Force the client prefix so a client can't reuse the server's IDs
+	ActivateAbilityInternal(FSimpleNetID::ToClientID(AbilityID), AbilityClass, AbilityContext, ActivationPolicy, true, ActivationTime);
+}
+
+void USimpleGameplayAbilityComponent::ServerActivateAbilities_Implementation(const TArray<FSimpleAbilityActivationRequest>& Requests, const float ActivationTime)
+{
+	for (const FSimpleAbilityActivationRequest& Request : Requests)
+	{
+		if (!Request.AbilityClass)
+		{
+			SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::ServerActivateAbilities]: AbilityClass is null!")));
+			continue;
+		}
+
+		ActivateAbilityInternal(FSimpleNetID::ToClientID(Request.AbilityID), Request.AbilityClass, Request.AbilityContext, Request.ActivationPolicyOverride, true, ActivationTime);
+	}
+}
+
+void USimpleGameplayAbilityComponent::ServerActivateAbilityCompact_Implementation(const FSimpleAbilityActivationNetRequest& Request, const uint16 ActivationTime)
+{
+	ActivateAbilityFromNetRequest(Request, FSimpleAbilityActivationNetRequest::DequantizeActivationTime(ActivationTime, GetCachedServerTime()));
+}
+
+void USimpleGameplayAbilityComponent::ServerActivateAbilitiesCompact_Implementation(const TArray<FSimpleAbilityActivationNetRequest>& Requests, const uint16 ActivationTime)
+{
+	const float DequantizedTime = FSimpleAbilityActivationNetRequest::DequantizeActivationTime(ActivationTime, GetCachedServerTime());
+	
+	for (const FSimpleAbilityActivationNetRequest& Request : Requests)
+	{
+		ActivateAbilityFromNetRequest(Request, DequantizedTime);
+	}
+}
+
+void USimpleGameplayAbilityComponent::AddActivatableAbilityClass(const TSubclassOf<USimpleGameplayAbility> AbilityClass)
+{
+	if (!AbilityClass || ActivatableAbilityClasses.Contains(AbilityClass))
+	{
+		return;
+	}
+
+	ActivatableAbilityClasses.Add(AbilityClass);
+	MARK_PROPERTY_DIRTY_FROM_NAME(USimpleGameplayAbilityComponent, ActivatableAbilityClasses, this);
+	NotifyReplicatedStateChanged();
+}
+
+bool USimpleGameplayAbilityComponent::MakeActivationNetRequest(
+	const FGuid AbilityID,
+	const TSubclassOf<USimpleGameplayAbility> AbilityClass,
+	const FInstancedStruct& AbilityContext,
+	const EAbilityActivationPolicy ActivationPolicy,
+	FSimpleAbilityActivationNetRequest& OutRequest) const
+{
+	// Iris can't use the request's custom NetSerialize, it gets the regular RPCs instead
+	if (IsUsingIrisReplication())
+	{
+		return false;
+	}
+	
+	const int32 ClassIndex = ActivatableAbilityClasses.IndexOfByKey(AbilityClass);
+
+	if (ClassIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutRequest.AbilityClassIndex = ClassIndex;
+	OutRequest.AbilityID = AbilityID;
+	OutRequest.AbilityContext = AbilityContext;
+	OutRequest.ActivationPolicy = ActivationPolicy;
+	
+	return true;
+}
+
+void USimpleGameplayAbilityComponent::ActivateAbilityFromNetRequest(const FSimpleAbilityActivationNetRequest& Request, const float ActivationTime)
+{
+	if (!ActivatableAbilityClasses.IsValidIndex(Request.AbilityClassIndex) || !ActivatableAbilityClasses[Request.AbilityClassIndex])
+	{
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::ActivateAbilityFromNetRequest]: Invalid ability class index %d."), Request.AbilityClassIndex));
+		return;
+	}
+
+	if (Request.ActivationPolicy > EAbilityActivationPolicy::ServerAuthority)
+	{
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::ActivateAbilityFromNetRequest]: Invalid activation policy %d."), static_cast<int32>(Request.ActivationPolicy)));
+		return;
+	}
+
+	// Only reached through server RPCs, force the client prefix so a client can't reuse the server's IDs
+	ActivateAbilityInternal(FSimpleNetID::ToClientID(Request.AbilityID), ActivatableAbilityClasses[Request.AbilityClassIndex], Request.AbilityContext, Request.ActivationPolicy, true, ActivationTime);
 }
 
 void USimpleGameplayAbilityComponent::OnAbilityEndedEventReceived(FGameplayTag EventTag, FGameplayTag Domain, FInstancedStruct Payload, UObject* Sender)
@@ -316,12 +661,23 @@ void USimpleGameplayAbilityComponent::OnAbilityEndedEventReceived(FGameplayTag E
 	}
 	
 	const EAbilityStatus StatusToSet = EndedEvent->WasCancelled ? EndedCancelled : EndedSuccessfully;
-	AbilityState->EndingContext = Payload;
 	AbilityState->AbilityStatus = StatusToSet;
 	
 	if (HasAuthority())
 	{
-		AuthorityAbilityStates.MarkItemDirty(*AbilityState);
+		MarkContainerItemDirty(AuthorityAbilityStates, *AbilityState);
+	}
+
+	// The ending context is only needed by clients to cancel their copy of the ability, so we only store it for cancellations
+	if (EndedEvent->WasCancelled)
+	{
+		FAbilityStatePayload* StatePayload = GetAbilityStatePayload(EndedEvent->AbilityID, HasAuthority(), true);
+		StatePayload->EndingContext = Payload;
+
+		if (HasAuthority())
+		{
+			MarkContainerItemDirty(AuthorityAbilityStatePayloads, *StatePayload);
+		}
 	}
 
 	OnAbilityEnded(EndedEvent->AbilityID, EndedEvent->EndStatusTag, EndedEvent->EndingContext, EndedEvent->WasCancelled);
@@ -342,14 +698,20 @@ FAbilityState& USimpleGameplayAbilityComponent::CreateAbilityState(
 	NewAbilityState.AbilityID = AbilityID;
 	NewAbilityState.ActivationPolicy = ActivationPolicy;
 	NewAbilityState.AbilityClass = AbilityClass;
-	NewAbilityState.ActivationTimeStamp = ActivationTime > 0 ? ActivationTime : GetServerTime();
-	NewAbilityState.ActivationContext = ActivationContext;
+	NewAbilityState.ActivationTimeStamp = ActivationTime > 0 ? ActivationTime : GetCachedServerTime();
 	NewAbilityState.AbilityStatus = PreActivation;
+	NewAbilityState.HasActivationContext = ActivationContext.IsValid();
+
+	if (NewAbilityState.HasActivationContext)
+	{
+		FAbilityStatePayload* StatePayload = GetAbilityStatePayload(AbilityID, IsAuthorityState, true);
+		StatePayload->ActivationContext = ActivationContext;
+	}
 	
 	if (IsAuthorityState)
 	{
 		AuthorityAbilityStates.AbilityStates.Add(NewAbilityState);
-		AuthorityAbilityStates.MarkArrayDirty();
+		MarkContainerDirty(AuthorityAbilityStates);
 		return AuthorityAbilityStates.AbilityStates.Last();
 	}
 
@@ -372,6 +734,63 @@ FAbilityState* USimpleGameplayAbilityComponent::GetAbilityState(const FGuid Abil
 	return nullptr;
 }
 
+FAbilityState* USimpleGameplayAbilityComponent::GetAttributeState(const FGuid AttributeInstanceID, const bool IsAuthorityState)
+{
+	TArray<FAbilityState>& AttributeStates = IsAuthorityState ? AuthorityAttributeStates.AbilityStates : LocalAttributeStates;
+	
+	for (FAbilityState& AttributeState : AttributeStates)
+	{
+		if (AttributeState.AbilityID == AttributeInstanceID)
+		{
+			return &AttributeState;
+		}
+	}
+
+	return nullptr;
+}
+
+FAbilityStatePayload* USimpleGameplayAbilityComponent::GetAbilityStatePayload(const FGuid AbilityID, const bool IsAuthorityState, const bool CreateIfMissing)
+{
+	return FindOrAddStatePayload(AuthorityAbilityStatePayloads, LocalAbilityStatePayloads, AbilityID, IsAuthorityState, CreateIfMissing);
+}
+
+FAbilityStatePayload* USimpleGameplayAbilityComponent::GetAttributeStatePayload(const FGuid AttributeInstanceID, const bool IsAuthorityState, const bool CreateIfMissing)
+{
+	return FindOrAddStatePayload(AuthorityAttributeStatePayloads, LocalAttributeStatePayloads, AttributeInstanceID, IsAuthorityState, CreateIfMissing);
+}
+
+FAbilityStatePayload* USimpleGameplayAbilityComponent::FindOrAddStatePayload(
+	FAbilityStatePayloadContainer& AuthorityPayloads,
+	TArray<FAbilityStatePayload>& LocalPayloads,
+	const FGuid StateID, const bool IsAuthorityState, const bool CreateIfMissing)
+{
+	TArray<FAbilityStatePayload>& Payloads = IsAuthorityState ? AuthorityPayloads.Payloads : LocalPayloads;
+	
+	for (FAbilityStatePayload& Payload : Payloads)
+	{
+		if (Payload.AbilityID == StateID)
+		{
+			return &Payload;
+		}
+	}
+
+	if (!CreateIfMissing)
+	{
+		return nullptr;
+	}
+
+	FAbilityStatePayload NewPayload;
+	NewPayload.AbilityID = StateID;
+	Payloads.Add(NewPayload);
+
+	if (IsAuthorityState)
+	{
+		MarkContainerDirty(AuthorityPayloads);
+	}
+
+	return &Payloads.Last();
+}
+
 USimpleAttributeHandler* USimpleGameplayAbilityComponent::GetAttributeHandler(const FGameplayTag AttributeTag)
 {
 	const FStructAttribute* StructAttribute = GetStructAttribute(AttributeTag);
@@ -423,7 +842,7 @@ bool USimpleGameplayAbilityComponent::SetAbilityStatus(const FGuid AbilityID, co
 
 	if (HasAuthority())
 	{
-		AuthorityAbilityStates.MarkItemDirty(*AbilityState);
+		MarkContainerItemDirty(AuthorityAbilityStates, *AbilityState);
 	}
 
 	return true;
@@ -450,46 +869,121 @@ USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetAbilityInstance(TSub
 	return InstancedAbilities.Last();	
 }
 
-bool USimpleGameplayAbilityComponent::CancelAbility(const FGuid AbilityInstanceID, const FInstancedStruct CancellationContext, const bool ForceCancel = false)
+USimpleAttributeModifier* USimpleGameplayAbilityComponent::AcquireAttributeModifier(TSubclassOf<USimpleAttributeModifier> ModifierClass)
 {
-	if (USimpleGameplayAbility* AbilityInstance = GetGameplayAbilityInstance(AbilityInstanceID))
+	USimpleAttributeModifier* Modifier = nullptr;
+
+	if (FAttributeModifierList* ModifierPool = AttributeModifierPools.Find(ModifierClass))
 	{
-		if (!AbilityInstance->IsAbilityActive())
-		{
-			return true;
-		}
-		
-		if (!ForceCancel && !AbilityInstance->CanCancel())
+		if (ModifierPool->Modifiers.Num() > 0)
 		{
-			SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::CancelAbility]: Ability %s CanCancel() returned false"), *AbilityInstance->GetName()));
-			return false;
+			Modifier = ModifierPool->Modifiers[0];
+			ModifierPool->Modifiers.RemoveAt(0);
+			Modifier->ResetModifier();
 		}
-		
-		AbilityInstance->CancelAbility(FDefaultTags::AbilityCancelled(), CancellationContext, ForceCancel);
-		return true;
 	}
 
-	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::CancelAbility]: Ability with ID %s not found in InstancedAbilities array"), *AbilityInstanceID.ToString()));
-	return false;
+	if (!Modifier)
+	{
+		Modifier = NewObject<USimpleAttributeModifier>(this, ModifierClass);
+	}
+
+	InstancedAttributes.Add(Modifier);
+	return Modifier;
 }
 
-TArray<FGuid> USimpleGameplayAbilityComponent::CancelAbilitiesWithTags(const FGameplayTagContainer Tags, FInstancedStruct CancellationContext)
+void USimpleGameplayAbilityComponent::ReleaseAttributeModifier(USimpleAttributeModifier* ModifierToRelease)
 {
-	TArray<FGuid> CancelledAbilities;
-	
-	for (USimpleGameplayAbility* AbilityInstance : InstancedAbilities)
+	// Modifiers can end more than once (e.g. cancelled while ending), only the first release counts
+	if (!ModifierToRelease || InstancedAttributes.RemoveSingleSwap(ModifierToRelease) == 0)
 	{
-		if (AbilityInstance->AbilityTags.HasAnyExact(Tags))
-		{
-			if (!AbilityInstance->CanCancel())
-			{
-				SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::CancelAbilitiesWithTags]: Ability %s CanCancel() returned false"), *AbilityInstance->GetName()));
-				continue;
-			}
-			
-			AbilityInstance->CancelAbility(FDefaultTags::AbilityCancelled(), CancellationContext);
-			CancelledAbilities.Add(AbilityInstance->AbilityInstanceID);
-		}
+		return;
+	}
+
+	if (HasAuthority())
+	{
+		EndedModifierStateIDs.Add(ModifierToRelease->AbilityInstanceID);
+		RemoveOldEndedModifierStates();
+	}
+
+	if (MaxPooledModifiersPerClass <= 0)
+	{
+		return;
+	}
+
+	FAttributeModifierList& ModifierPool = AttributeModifierPools.FindOrAdd(ModifierToRelease->GetClass());
+
+	// Make room by dropping the modifier that ended first
+	if (ModifierPool.Modifiers.Num() >= MaxPooledModifiersPerClass)
+	{
+		ModifierPool.Modifiers.RemoveAt(0, ModifierPool.Modifiers.Num() - MaxPooledModifiersPerClass + 1);
+	}
+
+	ModifierPool.Modifiers.Add(ModifierToRelease);
+}
+
+void USimpleGameplayAbilityComponent::RemoveOldEndedModifierStates()
+{
+	const int32 NumStatesToRemove = EndedModifierStateIDs.Num() - FMath::Max(MaxEndedModifierStates, 0);
+
+	if (NumStatesToRemove <= 0)
+	{
+		return;
+	}
+
+	// Clients drop their local state and payload for the modifier when the authority state is removed
+	for (int32 i = 0; i < NumStatesToRemove; i++)
+	{
+		const FGuid StateID = EndedModifierStateIDs[i];
+		AuthorityAttributeStates.AbilityStates.RemoveAll([StateID](const FAbilityState& State) { return State.AbilityID == StateID; });
+		AuthorityAttributeStatePayloads.Payloads.RemoveAll([StateID](const FAbilityStatePayload& Payload) { return Payload.AbilityID == StateID; });
+	}
+
+	EndedModifierStateIDs.RemoveAt(0, NumStatesToRemove);
+	MarkContainerDirty(AuthorityAttributeStates);
+	MarkContainerDirty(AuthorityAttributeStatePayloads);
+}
+
+bool USimpleGameplayAbilityComponent::CancelAbility(const FGuid AbilityInstanceID, const FInstancedStruct CancellationContext, const bool ForceCancel = false)
+{
+	if (USimpleGameplayAbility* AbilityInstance = GetGameplayAbilityInstance(AbilityInstanceID))
+	{
+		if (!AbilityInstance->IsAbilityActive())
+		{
+			return true;
+		}
+		
+		if (!ForceCancel && !AbilityInstance->CanCancel())
+		{
+			SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::CancelAbility]: Ability %s CanCancel() returned false"), *AbilityInstance->GetName()));
+			return false;
+		}
+		
+		AbilityInstance->CancelAbility(FDefaultTags::AbilityCancelled(), CancellationContext, ForceCancel);
+		return true;
+	}
+
+	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::CancelAbility]: Ability with ID %s not found in InstancedAbilities array"), *AbilityInstanceID.ToString()));
+	return false;
+}
+
+TArray<FGuid> USimpleGameplayAbilityComponent::CancelAbilitiesWithTags(const FGameplayTagContainer Tags, FInstancedStruct CancellationContext)
+{
+	TArray<FGuid> CancelledAbilities;
+	
+	for (USimpleGameplayAbility* AbilityInstance : InstancedAbilities)
+	{
+		if (AbilityInstance->AbilityTags.HasAnyExact(Tags))
+		{
+			if (!AbilityInstance->CanCancel())
+			{
+				SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::CancelAbilitiesWithTags]: Ability %s CanCancel() returned false"), *AbilityInstance->GetName()));
+				continue;
+			}
+			
+			AbilityInstance->CancelAbility(FDefaultTags::AbilityCancelled(), CancellationContext);
+			CancelledAbilities.Add(AbilityInstance->AbilityInstanceID);
+		}
 	}
 	
 	return CancelledAbilities;
@@ -505,15 +999,29 @@ bool USimpleGameplayAbilityComponent::IsAvatarActorOfType(TSubclassOf<AActor> Av
 	return false;
 }
 
+void USimpleGameplayAbilityComponent::SetAvatarActor(AActor* NewAvatarActor)
+{
+	AvatarActor = NewAvatarActor;
+	MARK_PROPERTY_DIRTY_FROM_NAME(USimpleGameplayAbilityComponent, AvatarActor, this);
+	NotifyReplicatedStateChanged();
+}
+
 void USimpleGameplayAbilityComponent::GrantAbility(const TSubclassOf<USimpleGameplayAbility> AbilityClass)
 {
 	GrantedAbilities.AddUnique(AbilityClass);
+	MARK_PROPERTY_DIRTY_FROM_NAME(USimpleGameplayAbilityComponent, GrantedAbilities, this);
+	NotifyReplicatedStateChanged();
+	AddActivatableAbilityClass(AbilityClass);
 	USimpleGameplayAbility::OnGrantedStatic(AbilityClass, this);
 }
 
 void USimpleGameplayAbilityComponent::RevokeAbility(const TSubclassOf<USimpleGameplayAbility> AbilityClass)
 {
-	GrantedAbilities.Remove(AbilityClass);
+	if (GrantedAbilities.Remove(AbilityClass) > 0)
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(USimpleGameplayAbilityComponent, GrantedAbilities, this);
+		NotifyReplicatedStateChanged();
+	}
 }
 
 void USimpleGameplayAbilityComponent::AddAbilityOverride(TSubclassOf<USimpleGameplayAbility> Ability, TSubclassOf<USimpleGameplayAbility> OverrideAbility)
@@ -523,6 +1031,8 @@ void USimpleGameplayAbilityComponent::AddAbilityOverride(TSubclassOf<USimpleGame
 	AbilityOverride.OverrideAbility = OverrideAbility;
 	
 	ActiveAbilityOverrides.AddUnique(AbilityOverride);
+	MARK_PROPERTY_DIRTY_FROM_NAME(USimpleGameplayAbilityComponent, ActiveAbilityOverrides, this);
+	NotifyReplicatedStateChanged();
 }
 
 void USimpleGameplayAbilityComponent::RemoveAbilityOverride(TSubclassOf<USimpleGameplayAbility> Ability)
@@ -532,54 +1042,54 @@ void USimpleGameplayAbilityComponent::RemoveAbilityOverride(TSubclassOf<USimpleG
 	if (FoundAbilityOverride)
 	{
 		ActiveAbilityOverrides.Remove(*FoundAbilityOverride);
+		MARK_PROPERTY_DIRTY_FROM_NAME(USimpleGameplayAbilityComponent, ActiveAbilityOverrides, this);
+		NotifyReplicatedStateChanged();
 	}
 }
 
 void USimpleGameplayAbilityComponent::AddAbilityStateSnapshot(FGuid AbilityInstanceID, FSimpleAbilitySnapshot State)
 {
-	if (HasAuthority())
+	if (!GetAbilityState(AbilityInstanceID, HasAuthority()))
 	{
-		for (FAbilityState& AuthorityAbilityState : AuthorityAbilityStates.AbilityStates)
-		{
-			if (AuthorityAbilityState.AbilityID == AbilityInstanceID)
-			{
-				AuthorityAbilityState.SnapshotHistory.Add(State);
-				AuthorityAbilityStates.MarkItemDirty(AuthorityAbilityState);
-				return;
-			}
-		}	
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::AddAbilityStateSnapshot]: Ability with ID %s not found in InstancedAbilities array"), *AbilityInstanceID.ToString()));
+		return;
 	}
-	else
+
+	FAbilityStatePayload* StatePayload = GetAbilityStatePayload(AbilityInstanceID, HasAuthority(), true);
+	StatePayload->SnapshotHistory.Add(State);
+
+	if (HasAuthority())
 	{
-		for (FAbilityState& ActiveAbility : LocalAbilityStates)
-		{
-			if (ActiveAbility.AbilityID == AbilityInstanceID)
-			{
-				ActiveAbility.SnapshotHistory.Add(State);
-				return;
-			}
-		}	
+		MarkContainerItemDirty(AuthorityAbilityStatePayloads, *StatePayload);
 	}
-
-	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::AddAbilityStateSnapshot]: Ability with ID %s not found in InstancedAbilities array"), *AbilityInstanceID.ToString()));
 }
 
 /* Tag Functions */
 
 void USimpleGameplayAbilityComponent::AddGameplayTag(FGameplayTag Tag, FInstancedStruct Payload)
 {
-	TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
+	if (!HasAuthority())
+	{
+		const FGameplayTagCounter* TagCounter = FindGameplayTagCounter(Tag);
+		const int32 ReferenceCounter = TagCounter ? TagCounter->ReferenceCounter : 0;
+
+		SetPredictedGameplayTagCount(Tag, ReferenceCounter + 1);
+
+		if (ReferenceCounter == 0)
+		{
+			SendEvent(FDefaultTags::GameplayTagAdded(), Tag, Payload, this, {}, ESimpleEventReplicationPolicy::NoReplication);
+		}
+		
+		return;
+	}
+	
+	TArray<FGameplayTagCounter>& TagCounters = AuthorityGameplayTags.Tags;
 	FGameplayTagCounter* TagCounter = TagCounters.FindByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); });
 
 	if (TagCounter)
 	{
 		TagCounter->ReferenceCounter++;
-		
-		if (HasAuthority())
-		{
-			AuthorityGameplayTags.MarkItemDirty(*TagCounter);
-		}
-		
+		MarkContainerItemDirty(AuthorityGameplayTags, *TagCounter);
 		return;
 	}
 
@@ -588,56 +1098,66 @@ void USimpleGameplayAbilityComponent::AddGameplayTag(FGameplayTag Tag, FInstance
 	NewTagCounter.ReferenceCounter = 1;
 	
 	TagCounters.AddUnique(NewTagCounter);
-
-	if (HasAuthority())
-	{
-		AuthorityGameplayTags.MarkArrayDirty();
-	}
+	MarkContainerDirty(AuthorityGameplayTags);
 	
 	SendEvent(FDefaultTags::GameplayTagAdded(), Tag, Payload, this, {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 void USimpleGameplayAbilityComponent::RemoveGameplayTag(FGameplayTag Tag, FInstancedStruct Payload)
 {
-	TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
-	FGameplayTagCounter* TagCounter = TagCounters.FindByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); });
-
-	if (TagCounter && TagCounter->ReferenceCounter > 1)
+	if (!HasAuthority())
 	{
-		TagCounter->ReferenceCounter--;
-		
-		if (HasAuthority())
+		const FGameplayTagCounter* TagCounter = FindGameplayTagCounter(Tag);
+		const int32 ReferenceCounter = TagCounter ? TagCounter->ReferenceCounter : 0;
+
+		if (ReferenceCounter <= 0)
+		{
+			return;
+		}
+
+		SetPredictedGameplayTagCount(Tag, ReferenceCounter - 1);
+
+		if (ReferenceCounter == 1)
 		{
-			AuthorityGameplayTags.MarkItemDirty(*TagCounter);
+			SendEvent(FDefaultTags::GameplayTagRemoved(), Tag, Payload, this, {}, ESimpleEventReplicationPolicy::NoReplication);
 		}
 		
 		return;
 	}
+	
+	TArray<FGameplayTagCounter>& TagCounters = AuthorityGameplayTags.Tags;
+	FGameplayTagCounter* TagCounter = TagCounters.FindByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); });
 
-	TagCounters.RemoveSingle(*TagCounter);
+	if (!TagCounter)
+	{
+		return;
+	}
 
-	if (HasAuthority())
+	if (TagCounter->ReferenceCounter > 1)
 	{
-		AuthorityGameplayTags.MarkArrayDirty();
+		TagCounter->ReferenceCounter--;
+		MarkContainerItemDirty(AuthorityGameplayTags, *TagCounter);
+		return;
 	}
+
+	TagCounters.RemoveSingle(*TagCounter);
+	MarkContainerDirty(AuthorityGameplayTags);
 	
 	SendEvent(FDefaultTags::GameplayTagRemoved(), Tag, Payload, this, {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 bool USimpleGameplayAbilityComponent::HasGameplayTag(FGameplayTag Tag)
 {
-	TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
-
-	return TagCounters.ContainsByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); });
+	const FGameplayTagCounter* TagCounter = FindGameplayTagCounter(Tag);
+	
+	return TagCounter && TagCounter->ReferenceCounter > 0;
 }
 
 bool USimpleGameplayAbilityComponent::HasAllGameplayTags(FGameplayTagContainer Tags)
 {
-	TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
-
 	for (const FGameplayTag& Tag : Tags)
 	{
-		if (!TagCounters.ContainsByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); }))
+		if (!HasGameplayTag(Tag))
 		{
 			return false;
 		}
@@ -648,11 +1168,9 @@ bool USimpleGameplayAbilityComponent::HasAllGameplayTags(FGameplayTagContainer T
 
 bool USimpleGameplayAbilityComponent::HasAnyGameplayTags(FGameplayTagContainer Tags)
 {
-	TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
-
 	for (const FGameplayTag& Tag : Tags)
 	{
-		if (TagCounters.ContainsByPredicate([Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); }))
+		if (HasGameplayTag(Tag))
 		{
 			return true;
 		}
@@ -665,8 +1183,15 @@ FGameplayTagContainer USimpleGameplayAbilityComponent::GetActiveGameplayTags() c
 {
 	FGameplayTagContainer ActiveGameplayTags;
 	
-	const TArray<FGameplayTagCounter>& TagCounters = HasAuthority() ? AuthorityGameplayTags.Tags : LocalGameplayTags;
-	for (const FGameplayTagCounter& TagCounter : TagCounters)
+	for (const FGameplayTagCounter& TagCounter : AuthorityGameplayTags.Tags)
+	{
+		if (TagCounter.ReferenceCounter > 0 && !PredictedGameplayTags.Contains(TagCounter))
+		{
+			ActiveGameplayTags.AddTag(TagCounter.GameplayTag);
+		}
+	}
+
+	for (const FGameplayTagCounter& TagCounter : PredictedGameplayTags)
 	{
 		if (TagCounter.ReferenceCounter > 0)
 		{
@@ -677,12 +1202,50 @@ FGameplayTagContainer USimpleGameplayAbilityComponent::GetActiveGameplayTags() c
 	return ActiveGameplayTags;
 }
 
+const FGameplayTagCounter* USimpleGameplayAbilityComponent::FindGameplayTagCounter(const FGameplayTag Tag) const
+{
+	auto MatchesTag = [Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); };
+	
+	if (const FGameplayTagCounter* PredictedTagCounter = PredictedGameplayTags.FindByPredicate(MatchesTag))
+	{
+		return PredictedTagCounter;
+	}
+
+	return AuthorityGameplayTags.Tags.FindByPredicate(MatchesTag);
+}
+
+void USimpleGameplayAbilityComponent::SetPredictedGameplayTagCount(const FGameplayTag Tag, const int32 ReferenceCounter)
+{
+	auto MatchesTag = [Tag](const FGameplayTagCounter& TagCounter) { return TagCounter.GameplayTag.MatchesTagExact(Tag); };
+	
+	const FGameplayTagCounter* ReplicatedTagCounter = AuthorityGameplayTags.Tags.FindByPredicate(MatchesTag);
+	const int32 ReplicatedReferenceCounter = ReplicatedTagCounter ? ReplicatedTagCounter->ReferenceCounter : 0;
+
+	// Only counts that differ from the replicated one are stored
+	if (ReferenceCounter == ReplicatedReferenceCounter)
+	{
+		PredictedGameplayTags.RemoveAllSwap(MatchesTag);
+		return;
+	}
+
+	if (FGameplayTagCounter* PredictedTagCounter = PredictedGameplayTags.FindByPredicate(MatchesTag))
+	{
+		PredictedTagCounter->ReferenceCounter = ReferenceCounter;
+		return;
+	}
+
+	FGameplayTagCounter& PredictedTagCounter = PredictedGameplayTags.AddDefaulted_GetRef();
+	PredictedTagCounter.GameplayTag = Tag;
+	PredictedTagCounter.ReferenceCounter = ReferenceCounter;
+}
+
 /* Event Functions */
 
 void USimpleGameplayAbilityComponent::SendEvent(FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
-                                                UObject* Sender, TArray<UObject*> ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy)
+                                                UObject* Sender, TArray<UObject*> ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy,
+                                                TSubclassOf<USimpleEventRelevancyPolicy> RelevancyPolicy)
 {
-	const FGuid EventID = FGuid::NewGuid();
+	const FGuid EventID = MakeNetID();
 
 	switch (ReplicationPolicy)
 	{
@@ -691,53 +1254,58 @@ void USimpleGameplayAbilityComponent::SendEvent(FGameplayTag EventTag, FGameplay
 			return;
 			
 		case ESimpleEventReplicationPolicy::ServerAndOwningClient:
+		case ESimpleEventReplicationPolicy::ServerAndOwningClientUnreliable:
 			if (!HasAuthority() && GetOwner()->HasLocalNetOwner())
 			{
-				ServerSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+				DispatchReplicatedEvent(EReplicatedEventTarget::Server, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 				return;
 			}
 		
-			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
-			ClientSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			// If we own this actor the client RPC runs here too
+			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter, GetOwner()->HasLocalNetOwner());
+			DispatchReplicatedEvent(EReplicatedEventTarget::OwningClient, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			break;
 
 		case ESimpleEventReplicationPolicy::ServerAndOwningClientPredicted:
-			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			// The event comes back from the server (or from our own client RPC) if we own this actor
+			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter, GetOwner()->HasLocalNetOwner());
 
 			if (HasAuthority())
 			{
-				ClientSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+				DispatchReplicatedEvent(EReplicatedEventTarget::OwningClient, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			}
 		
 			if (!HasAuthority() && GetOwner()->HasLocalNetOwner())
 			{
-				ServerSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+				DispatchReplicatedEvent(EReplicatedEventTarget::Server, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			}
 			break;
 		
 		case ESimpleEventReplicationPolicy::AllConnectedClients:
+		case ESimpleEventReplicationPolicy::AllConnectedClientsUnreliable:
 			if (!HasAuthority() && GetOwner()->HasLocalNetOwner())
 			{
-				ServerSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+				DispatchReplicatedEvent(EReplicatedEventTarget::Server, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 				return;
 			}
 
-			MulticastSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			DispatchReplicatedEvent(EReplicatedEventTarget::AllClients, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter, RelevancyPolicy);
 			break;
 
 		case ESimpleEventReplicationPolicy::AllConnectedClientsPredicted:
 
 			if (HasAuthority())
 			{
-				MulticastSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+				DispatchReplicatedEvent(EReplicatedEventTarget::AllClients, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter, RelevancyPolicy);
 				break;
 			}
 
-			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			// The server multicasts the event back to us if we can send it
+			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter, GetOwner()->HasLocalNetOwner());
 		
 			if (!HasAuthority() && GetOwner()->HasLocalNetOwner())
 			{
-				ServerSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+				DispatchReplicatedEvent(EReplicatedEventTarget::Server, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			}
 			break;
 	}
@@ -745,7 +1313,7 @@ void USimpleGameplayAbilityComponent::SendEvent(FGameplayTag EventTag, FGameplay
 
 void USimpleGameplayAbilityComponent::SendEventInternal(FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag,
 	const FInstancedStruct& Payload, UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy,
-	const TArray<UObject*>& ListenerFilter)
+	const TArray<UObject*>& ListenerFilter, const bool ExpectsEcho)
 {
 	USimpleEventSubsystem* EventSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>();
 	
@@ -755,21 +1323,60 @@ void USimpleGameplayAbilityComponent::SendEventInternal(FGuid EventID, FGameplay
 		return;
 	}
 	
-	if (HandledEventIDs.Contains(EventID))
+	// The entry in HandledEventIDQueue is left behind and popped once it reaches the front
+	if (HandledEventIDs.Remove(EventID) > 0)
 	{
-		HandledEventIDs.Remove(EventID);
+		ExpireHandledEventIDs();
 		return;
 	}
 
 	EventSubsystem->SendEvent(EventTag, DomainTag, Payload, Sender, ListenerFilter);
 
-	// No need to keep track of handled events if we're not replicating
-	if (ReplicationPolicy == ESimpleEventReplicationPolicy::NoReplication)
+	// Only events that will come back to us need to be remembered, received events are never echoed
+	if (!ExpectsEcho || ReplicationPolicy == ESimpleEventReplicationPolicy::NoReplication)
 	{
 		return;
 	}
 	
+	AddHandledEventID(EventID);
+}
+
+void USimpleGameplayAbilityComponent::AddHandledEventID(const FGuid EventID)
+{
+	ExpireHandledEventIDs();
+	
 	HandledEventIDs.Add(EventID);
+	HandledEventIDQueue.Enqueue(TPair<FGuid, double>(EventID, GetWorld()->GetRealTimeSeconds()));
+	HandledEventIDQueueNum++;
+}
+
+void USimpleGameplayAbilityComponent::ExpireHandledEventIDs()
+{
+	const double ExpiryTime = GetWorld()->GetRealTimeSeconds() - HandledEventIDLifetime;
+	TPair<FGuid, double>* OldestHandledEvent = HandledEventIDQueue.Peek();
+
+	while (OldestHandledEvent)
+	{
+		// Always make room for the ID that's about to be added
+		const bool IsOverCapacity = HandledEventIDQueueNum >= MaxHandledEventIDs;
+		// Confirmed events were already removed from HandledEventIDs and don't need to wait for their expiry
+		const bool IsConfirmed = !HandledEventIDs.Contains(OldestHandledEvent->Key);
+
+		if (OldestHandledEvent->Value > ExpiryTime && !IsOverCapacity && !IsConfirmed)
+		{
+			break;
+		}
+
+		if (!IsConfirmed)
+		{
+			HandledEventIDs.Remove(OldestHandledEvent->Key);
+			UnconfirmedEventCount++;
+		}
+
+		HandledEventIDQueue.Pop();
+		HandledEventIDQueueNum--;
+		OldestHandledEvent = HandledEventIDQueue.Peek();
+	}
 }
 
 void USimpleGameplayAbilityComponent::ServerSendEvent_Implementation(
@@ -781,24 +1388,29 @@ void USimpleGameplayAbilityComponent::ServerSendEvent_Implementation(
 	ESimpleEventReplicationPolicy ReplicationPolicy,
 	const TArray<UObject*>& ListenerFilter)
 {
+	// Force the client prefix so a client can't reuse the server's IDs
+	EventID = FSimpleNetID::ToClientID(EventID);
+	
 	switch (ReplicationPolicy)
 	{
 		case ESimpleEventReplicationPolicy::ServerAndOwningClient:
+		case ESimpleEventReplicationPolicy::ServerAndOwningClientUnreliable:
 			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, {});
-			ClientSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			DispatchReplicatedEvent(EReplicatedEventTarget::OwningClient, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			break;
 		
 		case ESimpleEventReplicationPolicy::ServerAndOwningClientPredicted:
 			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, {});
-			ClientSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			DispatchReplicatedEvent(EReplicatedEventTarget::OwningClient, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			break;
 		
 		case ESimpleEventReplicationPolicy::AllConnectedClients:
-			MulticastSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+		case ESimpleEventReplicationPolicy::AllConnectedClientsUnreliable:
+			DispatchReplicatedEvent(EReplicatedEventTarget::AllClients, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			break;
 		
 		case ESimpleEventReplicationPolicy::AllConnectedClientsPredicted:
-			MulticastSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			DispatchReplicatedEvent(EReplicatedEventTarget::AllClients, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
 			break;
 		default:
 			break;
@@ -819,105 +1431,844 @@ void USimpleGameplayAbilityComponent::MulticastSendEvent_Implementation(FGuid Ev
 	SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, {});
 }
 
-/* Utility Functions */
+void USimpleGameplayAbilityComponent::ServerSendEventUnreliable_Implementation(FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag,
+	FInstancedStruct Payload, UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter)
+{
+	ServerSendEvent_Implementation(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+}
 
-void USimpleGameplayAbilityComponent::RemoveInstancedAbility(USimpleGameplayAbility* AbilityToRemove)
+void USimpleGameplayAbilityComponent::ClientSendEventUnreliable_Implementation(FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag,
+	FInstancedStruct Payload, UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter)
 {
-	InstancedAbilities.Remove(AbilityToRemove);
+	SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, {});
 }
 
-USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetGameplayAbilityInstance(FGuid AbilityInstanceID)
+void USimpleGameplayAbilityComponent::MulticastSendEventUnreliable_Implementation(FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag,
+	FInstancedStruct Payload, UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter)
 {
-	for (USimpleGameplayAbility* InstancedAbility : InstancedAbilities)
+	SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, {});
+}
+
+void USimpleGameplayAbilityComponent::ServerSendEventBatch_Implementation(const TArray<FReplicatedEventBatchEntry>& Events)
+{
+	for (const FReplicatedEventBatchEntry& Event : Events)
 	{
-		if (InstancedAbility->AbilityInstanceID == AbilityInstanceID)
-		{
-			return InstancedAbility;
-		}
+		// ServerSendEvent_Implementation forces the client prefix
+		const FGuid EventID = FSimpleNetID::FromCompactID(Event.CompactEventID);
+		ServerSendEvent_Implementation(EventID, Event.EventTag, Event.DomainTag, Event.Payload, Event.Sender, Event.ReplicationPolicy, Event.ListenerFilter);
 	}
-	
-	return nullptr;
 }
 
-USimpleAttributeModifier* USimpleGameplayAbilityComponent::GetAttributeModifierInstance(FGuid AttributeInstanceID)
+void USimpleGameplayAbilityComponent::ClientSendEventBatch_Implementation(const TArray<FReplicatedEventBatchEntry>& Events)
 {
-	for (USimpleAttributeModifier* InstancedModifier : InstancedAttributes)
+	for (const FReplicatedEventBatchEntry& Event : Events)
 	{
-		if (InstancedModifier->AbilityInstanceID == AttributeInstanceID)
-		{
-			return InstancedModifier;
-		}
+		SendEventInternal(Event.GetEventID(), Event.EventTag, Event.DomainTag, Event.Payload, Event.Sender, Event.ReplicationPolicy, {});
 	}
-
-	return nullptr;
 }
 
-TArray<FSimpleAbilitySnapshot>* USimpleGameplayAbilityComponent::GetLocalAttributeStateSnapshots(const FGuid AttributeInstanceID)
+void USimpleGameplayAbilityComponent::MulticastSendEventBatch_Implementation(const TArray<FReplicatedEventBatchEntry>& Events)
 {
-	for (FAbilityState& AttributeState : LocalAttributeStates)
+	for (const FReplicatedEventBatchEntry& Event : Events)
 	{
-		if (AttributeState.AbilityID == AttributeInstanceID)
-		{
-			return &AttributeState.SnapshotHistory;
-		}
+		SendEventInternal(Event.GetEventID(), Event.EventTag, Event.DomainTag, Event.Payload, Event.Sender, Event.ReplicationPolicy, {});
 	}
-
-	return nullptr;
 }
 
-bool USimpleGameplayAbilityComponent::IsAbilityOnCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass)
+void USimpleGameplayAbilityComponent::ServerSendEventBatchUnreliable_Implementation(const TArray<FReplicatedEventBatchEntry>& Events)
 {
-	return LastActivatedAbilityTimeStamps.Contains(AbilityClass) && LastActivatedAbilityTimeStamps[AbilityClass] + AbilityClass.GetDefaultObject()->Cooldown > GetServerTime();
+	ServerSendEventBatch_Implementation(Events);
 }
 
-float USimpleGameplayAbilityComponent::GetAbilityCooldownTimeRemaining(TSubclassOf<USimpleGameplayAbility> AbilityClass)
+void USimpleGameplayAbilityComponent::ClientSendEventBatchUnreliable_Implementation(const TArray<FReplicatedEventBatchEntry>& Events)
 {
-	if (!LastActivatedAbilityTimeStamps.Contains(AbilityClass))
-	{
-		return 0.0f;
-	}
+	ClientSendEventBatch_Implementation(Events);
+}
 
-	return FMath::Clamp(LastActivatedAbilityTimeStamps[AbilityClass] + AbilityClass.GetDefaultObject()->Cooldown - GetServerTime(), 0.0f, AbilityClass.GetDefaultObject()->Cooldown);
+void USimpleGameplayAbilityComponent::MulticastSendEventBatchUnreliable_Implementation(const TArray<FReplicatedEventBatchEntry>& Events)
+{
+	MulticastSendEventBatch_Implementation(Events);
 }
 
-double USimpleGameplayAbilityComponent::GetServerTime_Implementation()
+void USimpleGameplayAbilityComponent::DispatchReplicatedEvent(
+	const EReplicatedEventTarget Target,
+	const FGuid EventID,
+	const FGameplayTag EventTag,
+	const FGameplayTag DomainTag,
+	const FInstancedStruct& Payload,
+	UObject* Sender,
+	const ESimpleEventReplicationPolicy ReplicationPolicy,
+	const TArray<UObject*>& ListenerFilter,
+	TSubclassOf<USimpleEventRelevancyPolicy> RelevancyPolicy)
 {
-	if (!GetWorld())
-	{
-		SIMPLE_LOG(this, TEXT("GetServerTime called but GetWorld is not valid!"));
-		return 0.0;
-	}
+	const bool IsReliable =
+		ReplicationPolicy != ESimpleEventReplicationPolicy::ServerAndOwningClientUnreliable &&
+		ReplicationPolicy != ESimpleEventReplicationPolicy::AllConnectedClientsUnreliable;
 
-	if (!GetWorld()->GetGameState())
+	// RPCs on a dormant actor are dropped
+	if (Target != EReplicatedEventTarget::Server)
 	{
-		SIMPLE_LOG(this, TEXT("GetServerTime called but GetGameState is not valid!"));
-		return 0.0;
+		NotifyReplicatedStateChanged();
 	}
-	
-	return GetWorld()->GetGameState()->GetServerWorldTimeSeconds();
-}
 
-bool USimpleGameplayAbilityComponent::HasAuthority() const
-{
-	if (GetOwner())
+	if (!IsReliable && IsUnreliableEventRateLimited(EventTag))
 	{
-		return GetOwner()->HasAuthority();
+		// Multicasts normally also run on the server so keep handling the event there
+		if (Target == EReplicatedEventTarget::AllClients)
+		{
+			SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+		}
+		
+		return;
 	}
 
-	return false;
-}
-
-bool USimpleGameplayAbilityComponent::IsAnyAbilityActive() const
-{
-	for (const USimpleGameplayAbility* AbilityInstance : InstancedAbilities)
+	if (Target == EReplicatedEventTarget::AllClients)
 	{
-		if (AbilityInstance->IsAbilityActive())
+		if (!RelevancyPolicy)
 		{
-			return true;
+			RelevancyPolicy = EventRelevancyPolicies.FindRef(EventTag);
 		}
-	}
 
-	return false;
+		if (RelevancyPolicy)
+		{
+			RelayRelevantEvent(RelevancyPolicy.GetDefaultObject(), IsReliable, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy);
+			return;
+		}
+	}
+	
+	if (ShouldBatchReplicatedEvents() && FSimpleNetID::IsCompact(EventID) &&
+		ListenerFilter.Num() <= FReplicatedEventBatchEntry::MaxListenerFilterNum)
+	{
+		FReplicatedEventBatchEntry& QueuedEvent = GetPendingEventQueue(Target, IsReliable).AddDefaulted_GetRef();
+		QueuedEvent.CompactEventID = FSimpleNetID::ToCompactID(EventID);
+		QueuedEvent.EventTag = EventTag;
+		QueuedEvent.DomainTag = DomainTag;
+		QueuedEvent.Payload = Payload;
+		QueuedEvent.Sender = Sender;
+		QueuedEvent.ReplicationPolicy = ReplicationPolicy;
+		QueuedEvent.ListenerFilter = ListenerFilter;
+
+		// Flush after all actors have ticked so everything sent this frame goes out in the same batch
+		if (!EventBatchFlushHandle.IsValid())
+		{
+			EventBatchFlushHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &USimpleGameplayAbilityComponent::OnWorldPostActorTick);
+		}
+		
+		return;
+	}
+
+	switch (Target)
+	{
+		case EReplicatedEventTarget::Server:
+			if (IsReliable)
+			{
+				ServerSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			}
+			else
+			{
+				ServerSendEventUnreliable(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			}
+			break;
+		
+		case EReplicatedEventTarget::OwningClient:
+			if (IsReliable)
+			{
+				ClientSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			}
+			else
+			{
+				ClientSendEventUnreliable(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			}
+			break;
+		
+		case EReplicatedEventTarget::AllClients:
+			if (IsReliable)
+			{
+				MulticastSendEvent(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			}
+			else
+			{
+				MulticastSendEventUnreliable(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, ListenerFilter);
+			}
+			break;
+	}
+}
+
+void USimpleGameplayAbilityComponent::RelayRelevantEvent(
+	const USimpleEventRelevancyPolicy* RelevancyPolicy,
+	const bool IsReliable,
+	const FGuid EventID,
+	const FGameplayTag EventTag,
+	const FGameplayTag DomainTag,
+	const FInstancedStruct& Payload,
+	UObject* Sender,
+	const ESimpleEventReplicationPolicy ReplicationPolicy)
+{
+	SendEventInternal(EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy, {});
+
+	FEventRelevancyStats& Stats = EventRelevancyStats.FindOrAdd(GetWorld()).FindOrAdd(RelevancyPolicy->GetClass()->GetFName());
+	Stats.Events++;
+
+	int32 CulledRPCs = 0;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		APlayerController* Receiver = It->Get();
+
+		// Local players were handled by SendEventInternal above
+		if (!Receiver || Receiver->IsLocalController())
+		{
+			continue;
+		}
+
+		if (!RelevancyPolicy->IsRelevantTo(this, Receiver, EventTag, Payload))
+		{
+			CulledRPCs++;
+			continue;
+		}
+
+		USimpleEventRelayComponent* Relay = USimpleEventRelayComponent::FindRelay(Receiver);
+
+		// Multicasting instead would send the event to every client, so clients without a relay miss it
+		if (!Relay)
+		{
+			if (!HasWarnedAboutMissingEventRelay)
+			{
+				UE_LOG(LogSimpleGAS, Warning, TEXT("[USimpleGameplayAbilityComponent::RelayRelevantEvent]: %s has no SimpleEventRelayComponent, it won't receive events with a relevancy policy."), *Receiver->GetName());
+				HasWarnedAboutMissingEventRelay = true;
+			}
+
+			Stats.SkippedRPCs++;
+			continue;
+		}
+
+		if (IsReliable)
+		{
+			Relay->ClientRelayEvent(this, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy);
+		}
+		else
+		{
+			Relay->ClientRelayEventUnreliable(this, EventID, EventTag, DomainTag, Payload, Sender, ReplicationPolicy);
+		}
+
+		Stats.SentRPCs++;
+		INC_DWORD_STAT(STAT_SimpleGAS_RelayedEventRPCs);
+	}
+
+	Stats.CulledRPCs += CulledRPCs;
+	INC_DWORD_STAT_BY(STAT_SimpleGAS_CulledEventRPCs, CulledRPCs);
+}
+
+bool USimpleGameplayAbilityComponent::IsUsingIrisReplication() const
+{
+#if UE_WITH_IRIS
+	if (const UNetDriver* NetDriver = GetOwner() ? GetOwner()->GetNetDriver() : nullptr)
+	{
+		return NetDriver->IsUsingIrisReplication();
+	}
+#endif
+
+	return false;
+}
+
+bool USimpleGameplayAbilityComponent::ShouldBatchReplicatedEvents() const
+{
+	// Batch entries serialize their sender and listeners through the package map, which Iris doesn't have.
+	// Under Iris events are sent with the per event RPCs instead.
+	return BatchReplicatedEvents && !IsUsingIrisReplication();
+}
+
+TArray<FReplicatedEventBatchEntry>& USimpleGameplayAbilityComponent::GetPendingEventQueue(const EReplicatedEventTarget Target, const bool IsReliable)
+{
+	switch (Target)
+	{
+		case EReplicatedEventTarget::Server:
+			return IsReliable ? PendingServerEvents : PendingUnreliableServerEvents;
+		
+		case EReplicatedEventTarget::OwningClient:
+			return IsReliable ? PendingClientEvents : PendingUnreliableClientEvents;
+		
+		default:
+			return IsReliable ? PendingMulticastEvents : PendingUnreliableMulticastEvents;
+	}
+}
+
+bool USimpleGameplayAbilityComponent::IsUnreliableEventRateLimited(const FGameplayTag EventTag)
+{
+	const float* MaxEventsPerSecond = UnreliableEventRateLimits.Find(EventTag);
+
+	if (!MaxEventsPerSecond || *MaxEventsPerSecond <= 0.0f)
+	{
+		return false;
+	}
+
+	const double CurrentTime = GetWorld()->GetRealTimeSeconds();
+	double& LastEventTime = LastUnreliableEventTimes.FindOrAdd(EventTag, -UE_BIG_NUMBER);
+
+	if (CurrentTime - LastEventTime < 1.0 / *MaxEventsPerSecond)
+	{
+		return true;
+	}
+
+	LastEventTime = CurrentTime;
+	return false;
+}
+
+void USimpleGameplayAbilityComponent::FlushReplicatedEvents()
+{
+	if (EventBatchFlushHandle.IsValid())
+	{
+		FWorldDelegates::OnWorldPostActorTick.Remove(EventBatchFlushHandle);
+		EventBatchFlushHandle.Reset();
+	}
+
+	if (PendingServerEvents.Num() > 0)
+	{
+		ServerSendEventBatch(PendingServerEvents);
+		PendingServerEvents.Reset();
+	}
+
+	if (PendingClientEvents.Num() > 0)
+	{
+		ClientSendEventBatch(PendingClientEvents);
+		PendingClientEvents.Reset();
+	}
+
+	if (PendingMulticastEvents.Num() > 0)
+	{
+		MulticastSendEventBatch(PendingMulticastEvents);
+		PendingMulticastEvents.Reset();
+	}
+
+	if (PendingUnreliableServerEvents.Num() > 0)
+	{
+		ServerSendEventBatchUnreliable(PendingUnreliableServerEvents);
+		PendingUnreliableServerEvents.Reset();
+	}
+
+	if (PendingUnreliableClientEvents.Num() > 0)
+	{
+		ClientSendEventBatchUnreliable(PendingUnreliableClientEvents);
+		PendingUnreliableClientEvents.Reset();
+	}
+
+	if (PendingUnreliableMulticastEvents.Num() > 0)
+	{
+		MulticastSendEventBatchUnreliable(PendingUnreliableMulticastEvents);
+		PendingUnreliableMulticastEvents.Reset();
+	}
+}
+
+void USimpleGameplayAbilityComponent::OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds)
+{
+	if (World == GetWorld())
+	{
+		FlushReplicatedEvents();
+	}
+}
+
+/* Utility Functions */
+
+void USimpleGameplayAbilityComponent::RemoveInstancedAbility(USimpleGameplayAbility* AbilityToRemove)
+{
+	InstancedAbilities.Remove(AbilityToRemove);
+}
+
+USimpleGameplayAbility* USimpleGameplayAbilityComponent::GetGameplayAbilityInstance(FGuid AbilityInstanceID)
+{
+	for (USimpleGameplayAbility* InstancedAbility : InstancedAbilities)
+	{
+		if (InstancedAbility->AbilityInstanceID == AbilityInstanceID)
+		{
+			return InstancedAbility;
+		}
+	}
+	
+	return nullptr;
+}
+
+USimpleAttributeModifier* USimpleGameplayAbilityComponent::GetAttributeModifierInstance(FGuid AttributeInstanceID)
+{
+	for (USimpleAttributeModifier* InstancedModifier : InstancedAttributes)
+	{
+		if (InstancedModifier->AbilityInstanceID == AttributeInstanceID)
+		{
+			return InstancedModifier;
+		}
+	}
+
+	for (const TPair<UClass*, FAttributeModifierList>& ModifierPool : AttributeModifierPools)
+	{
+		for (USimpleAttributeModifier* PooledModifier : ModifierPool.Value.Modifiers)
+		{
+			if (PooledModifier->AbilityInstanceID == AttributeInstanceID)
+			{
+				return PooledModifier;
+			}
+		}
+	}
+
+	return nullptr;
+}
+
+TArray<FSimpleAbilitySnapshot>* USimpleGameplayAbilityComponent::GetLocalAttributeStateSnapshots(const FGuid AttributeInstanceID)
+{
+	if (FAbilityStatePayload* StatePayload = GetAttributeStatePayload(AttributeInstanceID, false))
+	{
+		return &StatePayload->SnapshotHistory;
+	}
+
+	return nullptr;
+}
+
+bool USimpleGameplayAbilityComponent::IsAbilityOnCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass)
+{
+	return GetAbilityCooldownTimeRemaining(AbilityClass) > 0.0f;
+}
+
+float USimpleGameplayAbilityComponent::GetAbilityCooldownTimeRemaining(TSubclassOf<USimpleGameplayAbility> AbilityClass)
+{
+	if (!AbilityClass)
+	{
+		return 0.0f;
+	}
+
+	const FAbilityCooldown* Cooldown = FindCooldown(AbilityClass, AbilityClass.GetDefaultObject()->CooldownTag);
+
+	if (!Cooldown)
+	{
+		return 0.0f;
+	}
+
+	return FMath::Max(static_cast<float>(Cooldown->CooldownEndTime - GetCachedServerTime()), 0.0f);
+}
+
+/* Cooldown Functions */
+
+void USimpleGameplayAbilityComponent::StartAbilityCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, const float Duration)
+{
+	if (!AbilityClass)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::StartAbilityCooldown]: AbilityClass is null!"));
+		return;
+	}
+
+	const float CooldownDuration = Duration < 0.0f ? GetAbilityCooldownDuration(AbilityClass) : Duration;
+	SetCooldown(AbilityClass, AbilityClass.GetDefaultObject()->CooldownTag, CooldownDuration);
+}
+
+void USimpleGameplayAbilityComponent::ModifyAbilityCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, const float TimeDelta)
+{
+	if (!AbilityClass)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ModifyAbilityCooldown]: AbilityClass is null!"));
+		return;
+	}
+
+	ModifyCooldown(AbilityClass, AbilityClass.GetDefaultObject()->CooldownTag, TimeDelta);
+}
+
+void USimpleGameplayAbilityComponent::ModifyCooldownByTag(const FGameplayTag CooldownTag, const float TimeDelta)
+{
+	if (!CooldownTag.IsValid())
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ModifyCooldownByTag]: CooldownTag is not valid."));
+		return;
+	}
+
+	ModifyCooldown(nullptr, CooldownTag, TimeDelta);
+}
+
+void USimpleGameplayAbilityComponent::ClearAbilityCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass)
+{
+	if (!AbilityClass)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ClearAbilityCooldown]: AbilityClass is null!"));
+		return;
+	}
+
+	RemoveCooldown(AbilityClass, AbilityClass.GetDefaultObject()->CooldownTag, true);
+}
+
+float USimpleGameplayAbilityComponent::GetCooldownTimeRemainingByTag(const FGameplayTag CooldownTag)
+{
+	if (!CooldownTag.IsValid())
+	{
+		return 0.0f;
+	}
+
+	const FAbilityCooldown* Cooldown = FindCooldown(nullptr, CooldownTag);
+
+	if (!Cooldown)
+	{
+		return 0.0f;
+	}
+
+	return FMath::Max(static_cast<float>(Cooldown->CooldownEndTime - GetCachedServerTime()), 0.0f);
+}
+
+float USimpleGameplayAbilityComponent::GetAbilityCooldownDuration_Implementation(TSubclassOf<USimpleGameplayAbility> AbilityClass)
+{
+	if (!AbilityClass)
+	{
+		return 0.0f;
+	}
+
+	return AbilityClass.GetDefaultObject()->Cooldown * CooldownDurationMultiplier;
+}
+
+FAbilityCooldown* USimpleGameplayAbilityComponent::FindCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, const FGameplayTag CooldownTag)
+{
+	TArray<FAbilityCooldown>& Cooldowns = HasAuthority() ? AuthorityAbilityCooldowns.Cooldowns : LocalAbilityCooldowns;
+	return Cooldowns.FindByPredicate([AbilityClass, CooldownTag](const FAbilityCooldown& Cooldown) { return Cooldown.MatchesKey(AbilityClass, CooldownTag); });
+}
+
+void USimpleGameplayAbilityComponent::SetCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, const FGameplayTag CooldownTag, const float Duration)
+{
+	if (Duration <= 0.0f)
+	{
+		return;
+	}
+
+	FAbilityCooldown* Cooldown = FindCooldown(AbilityClass, CooldownTag);
+
+	if (!Cooldown)
+	{
+		TArray<FAbilityCooldown>& Cooldowns = HasAuthority() ? AuthorityAbilityCooldowns.Cooldowns : LocalAbilityCooldowns;
+
+		FAbilityCooldown NewCooldown;
+		NewCooldown.CooldownTag = CooldownTag;
+		Cooldowns.Add(NewCooldown);
+		Cooldown = &Cooldowns.Last();
+
+		if (HasAuthority())
+		{
+			MarkContainerDirty(AuthorityAbilityCooldowns);
+		}
+	}
+
+	Cooldown->AbilityClass = AbilityClass;
+	Cooldown->CooldownEndTime = GetCachedServerTime() + Duration;
+	Cooldown->CooldownDuration = Duration;
+
+	if (HasAuthority())
+	{
+		MarkContainerItemDirty(AuthorityAbilityCooldowns, *Cooldown);
+	}
+
+	ScheduleCooldownExpiry(*Cooldown);
+}
+
+void USimpleGameplayAbilityComponent::ModifyCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, const FGameplayTag CooldownTag, const float TimeDelta)
+{
+	FAbilityCooldown* Cooldown = FindCooldown(AbilityClass, CooldownTag);
+
+	if (!Cooldown)
+	{
+		return;
+	}
+
+	Cooldown->CooldownEndTime += TimeDelta;
+	Cooldown->CooldownDuration = FMath::Max(Cooldown->CooldownDuration + TimeDelta, 0.0f);
+
+	if (Cooldown->CooldownEndTime <= GetCachedServerTime())
+	{
+		RemoveCooldown(AbilityClass, CooldownTag, true);
+		return;
+	}
+
+	if (HasAuthority())
+	{
+		MarkContainerItemDirty(AuthorityAbilityCooldowns, *Cooldown);
+	}
+
+	ScheduleCooldownExpiry(*Cooldown);
+}
+
+void USimpleGameplayAbilityComponent::RemoveCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, const FGameplayTag CooldownTag, const bool SendEndedEvent)
+{
+	TArray<FAbilityCooldown>& Cooldowns = HasAuthority() ? AuthorityAbilityCooldowns.Cooldowns : LocalAbilityCooldowns;
+	const int32 CooldownIndex = Cooldowns.IndexOfByPredicate([AbilityClass, CooldownTag](const FAbilityCooldown& Cooldown) { return Cooldown.MatchesKey(AbilityClass, CooldownTag); });
+
+	if (CooldownIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	CancelCooldownExpiry(Cooldowns[CooldownIndex]);
+
+	FAbilityCooldownEndedEvent CooldownEndedEvent;
+	CooldownEndedEvent.AbilityClass = Cooldowns[CooldownIndex].AbilityClass;
+	CooldownEndedEvent.CooldownTag = Cooldowns[CooldownIndex].CooldownTag;
+
+	Cooldowns.RemoveAt(CooldownIndex);
+
+	if (HasAuthority())
+	{
+		MarkContainerDirty(AuthorityAbilityCooldowns);
+	}
+
+	if (SendEndedEvent)
+	{
+		const FGameplayTag DomainTag = HasAuthority() ? FDefaultTags::AuthorityAbilityDomain() : FDefaultTags::LocalAbilityDomain();
+		SendEvent(FDefaultTags::AbilityCooldownEnded(), DomainTag, FInstancedStruct::Make(CooldownEndedEvent), this, {}, ESimpleEventReplicationPolicy::NoReplication);
+	}
+}
+
+void USimpleGameplayAbilityComponent::ScheduleCooldownExpiry(FAbilityCooldown& Cooldown)
+{
+	USimpleTimerSubsystem* TimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USimpleTimerSubsystem>() : nullptr;
+
+	if (!TimerSubsystem)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ScheduleCooldownExpiry]: SimpleTimerSubsystem not found. Cooldown ended events will not be sent."));
+		return;
+	}
+
+	CancelCooldownExpiry(Cooldown);
+
+	// The timer wheel runs on the game state clock, which can differ from an overridden GetServerTime, so we schedule relative to now
+	const double TimeRemaining = Cooldown.CooldownEndTime - GetCachedServerTime();
+	const FSimpleTimerDelegate ExpiryDelegate = FSimpleTimerDelegate::CreateWeakLambda(this, [this, AbilityClass = Cooldown.AbilityClass, CooldownTag = Cooldown.CooldownTag]()
+	{
+		OnCooldownExpired(AbilityClass, CooldownTag);
+	});
+
+	Cooldown.ExpiryTimerHandle = TimerSubsystem->ScheduleTimer(TimerSubsystem->GetTimerTime() + TimeRemaining, ExpiryDelegate);
+}
+
+void USimpleGameplayAbilityComponent::CancelCooldownExpiry(FAbilityCooldown& Cooldown)
+{
+	if (Cooldown.ExpiryTimerHandle == 0)
+	{
+		return;
+	}
+
+	if (USimpleTimerSubsystem* TimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USimpleTimerSubsystem>() : nullptr)
+	{
+		TimerSubsystem->CancelTimer(Cooldown.ExpiryTimerHandle);
+	}
+
+	Cooldown.ExpiryTimerHandle = 0;
+}
+
+void USimpleGameplayAbilityComponent::OnCooldownExpired(TSubclassOf<USimpleGameplayAbility> AbilityClass, const FGameplayTag CooldownTag)
+{
+	FAbilityCooldown* Cooldown = FindCooldown(AbilityClass, CooldownTag);
+
+	if (!Cooldown)
+	{
+		return;
+	}
+
+	Cooldown->ExpiryTimerHandle = 0;
+
+	// The clocks drifted apart slightly, try again once the cooldown has actually ended
+	if (Cooldown->CooldownEndTime > GetCachedServerTime())
+	{
+		ScheduleCooldownExpiry(*Cooldown);
+		return;
+	}
+
+	RemoveCooldown(AbilityClass, CooldownTag, true);
+}
+
+double USimpleGameplayAbilityComponent::GetServerTime_Implementation()
+{
+	if (!GetWorld())
+	{
+		SIMPLE_LOG(this, TEXT("GetServerTime called but GetWorld is not valid!"));
+		return 0.0;
+	}
+
+	if (const USimpleNetworkClockComponent* Clock = GetNetworkClock())
+	{
+		return Clock->GetServerTime();
+	}
+
+	if (!GetWorld()->GetGameState())
+	{
+		SIMPLE_LOG(this, TEXT("GetServerTime called but GetGameState is not valid!"));
+		return 0.0;
+	}
+	
+	return GetWorld()->GetGameState()->GetServerWorldTimeSeconds();
+}
+
+double USimpleGameplayAbilityComponent::GetCachedServerTime()
+{
+	if (CachedServerTimeFrame != GFrameCounter)
+	{
+		CachedServerTime = GetServerTime();
+		CachedServerTimeFrame = GFrameCounter;
+	}
+
+	return CachedServerTime;
+}
+
+void USimpleGameplayAbilityComponent::InvalidateCachedServerTime()
+{
+	CachedServerTimeFrame = MAX_uint64;
+}
+
+USimpleNetworkClockComponent* USimpleGameplayAbilityComponent::GetNetworkClock()
+{
+	if (!UseNetworkClock || HasAuthority())
+	{
+		return nullptr;
+	}
+
+	// The clock's PlayerController can replicate after us, so keep looking for it but not every frame
+	if (!NetworkClock.IsValid() && GetWorld()->GetTimeSeconds() >= NextNetworkClockLookupTime)
+	{
+		NextNetworkClockLookupTime = GetWorld()->GetTimeSeconds() + 1.0;
+		NetworkClock = USimpleNetworkClockComponent::FindLocalClock(GetWorld());
+
+		if (NetworkClock.IsValid())
+		{
+			NetworkClock->OnClockResynced.AddUObject(this, &USimpleGameplayAbilityComponent::InvalidateCachedServerTime);
+		}
+	}
+
+	USimpleNetworkClockComponent* Clock = NetworkClock.Get();
+	return Clock && Clock->IsSynchronized() ? Clock : nullptr;
+}
+
+FGuid USimpleGameplayAbilityComponent::MakeNetID() const
+{
+	return FSimpleNetID::NewID(!HasAuthority());
+}
+
+bool USimpleGameplayAbilityComponent::IsQuiescent() const
+{
+	for (const USimpleGameplayAbility* Ability : InstancedAbilities)
+	{
+		if (Ability && Ability->IsAbilityActive())
+		{
+			return false;
+		}
+	}
+
+	for (const USimpleAttributeModifier* Modifier : InstancedAttributes)
+	{
+		if (Modifier && Modifier->IsModifierActive())
+		{
+			return false;
+		}
+	}
+
+	return PendingFloatAttributeReplications.Num() == 0 &&
+		PendingServerEvents.Num() == 0 && PendingClientEvents.Num() == 0 && PendingMulticastEvents.Num() == 0 &&
+		PendingUnreliableServerEvents.Num() == 0 && PendingUnreliableClientEvents.Num() == 0 && PendingUnreliableMulticastEvents.Num() == 0;
+}
+
+void USimpleGameplayAbilityComponent::NotifyReplicatedStateChanged()
+{
+	if (!IsTrackingIdleDormancy)
+	{
+		return;
+	}
+
+	LastReplicatedStateChangeTime = GetWorld()->GetTimeSeconds();
+
+	if (IdleDormant)
+	{
+		SetIdleDormant(false);
+	}
+
+	// A pending check reschedules itself if something changed since it was scheduled
+	if (DormancyCheckTimerHandle == 0)
+	{
+		ScheduleDormancyCheck(IdleDormancyDelay);
+	}
+}
+
+void USimpleGameplayAbilityComponent::ScheduleDormancyCheck(const double Delay)
+{
+	USimpleTimerSubsystem* TimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USimpleTimerSubsystem>() : nullptr;
+
+	if (!TimerSubsystem)
+	{
+		return;
+	}
+
+	const FSimpleTimerDelegate CheckDelegate = FSimpleTimerDelegate::CreateWeakLambda(this, [this]()
+	{
+		OnDormancyCheck();
+	});
+
+	DormancyCheckTimerHandle = TimerSubsystem->ScheduleTimer(TimerSubsystem->GetTimerTime() + Delay, CheckDelegate);
+}
+
+void USimpleGameplayAbilityComponent::OnDormancyCheck()
+{
+	DormancyCheckTimerHandle = 0;
+
+	if (!IsTrackingIdleDormancy || IdleDormant)
+	{
+		return;
+	}
+
+	const double IdleTime = GetWorld()->GetTimeSeconds() - LastReplicatedStateChangeTime;
+
+	if (IdleTime < IdleDormancyDelay)
+	{
+		ScheduleDormancyCheck(IdleDormancyDelay - IdleTime);
+		return;
+	}
+
+	if (!IsQuiescent())
+	{
+		ScheduleDormancyCheck(IdleDormancyDelay);
+		return;
+	}
+
+	SetIdleDormant(true);
+}
+
+void USimpleGameplayAbilityComponent::SetIdleDormant(const bool Dormant)
+{
+	AActor* Owner = GetOwner();
+
+	if (!Owner || IdleDormant == Dormant)
+	{
+		return;
+	}
+
+	IdleDormant = Dormant;
+
+	if (Dormant)
+	{
+		Owner->SetNetDormancy(DORM_DormantAll);
+		INC_DWORD_STAT(STAT_SimpleGAS_IdleDormantComponents);
+		return;
+	}
+
+	Owner->SetNetDormancy(DORM_Awake);
+	DEC_DWORD_STAT(STAT_SimpleGAS_IdleDormantComponents);
+}
+
+bool USimpleGameplayAbilityComponent::HasAuthority() const
+{
+	if (GetOwner())
+	{
+		return GetOwner()->HasAuthority();
+	}
+
+	return false;
+}
+
+bool USimpleGameplayAbilityComponent::IsAnyAbilityActive() const
+{
+	for (const USimpleGameplayAbility* AbilityInstance : InstancedAbilities)
+	{
+		if (AbilityInstance->IsAbilityActive())
+		{
+			return true;
+		}
+	}
+
+	return false;
 }
 
 bool USimpleGameplayAbilityComponent::DoesAbilityHaveOverride(TSubclassOf<USimpleGameplayAbility> AbilityClass) const
@@ -941,89 +2292,48 @@ void USimpleGameplayAbilityComponent::OnStateAdded(const FAbilityState& NewAbili
 	{
 		return;
 	}
-	
-	// A mapping of the local ability states for quick lookups
-	TMap<FGuid, int32> LocalStateArrayIndexMap;
 
 	// Added a new gameplay ability state
 	if (NewAbilityState.AbilityClass->IsChildOf(USimpleGameplayAbility::StaticClass()))
 	{
-		// Get a mapping of the local ability states for quick lookups
-		for (int32 i = 0; i < LocalAbilityStates.Num(); i++)
+		// If the NewAbilityState already exists locally the client predicted it. Snapshots are compared once the payload replicates.
+		if (GetAbilityState(NewAbilityState.AbilityID, false))
 		{
-			LocalStateArrayIndexMap.Add(LocalAbilityStates[i].AbilityID, i);
+			return;
 		}
-	
-		// If the NewAbilityState doesn't exist locally, we activate it
-		if (!LocalStateArrayIndexMap.Contains(NewAbilityState.AbilityID))
-		{
-			if (NewAbilityState.ActivationPolicy == EAbilityActivationPolicy::ServerOnly)
-			{
-				return;
-			}
-			
-			const TSubclassOf<USimpleGameplayAbility> AbilityClass = static_cast<TSubclassOf<USimpleGameplayAbility>>(NewAbilityState.AbilityClass);
 
-			LocalAbilityStates.AddUnique(NewAbilityState);
-			LocalStateArrayIndexMap.Add(NewAbilityState.AbilityID, LocalAbilityStates.Num() - 1);
+		if (NewAbilityState.ActivationPolicy == EAbilityActivationPolicy::ServerOnly)
+		{
+			return;
+		}
 
-			if (NewAbilityState.AbilityStatus != ActivationSuccess && NewAbilityState.AbilityStatus != EndedSuccessfully)
-			{
-				return;
-			}
-			
-			USimpleGameplayAbility* NewAbilityInstance = GetAbilityInstance(AbilityClass);
+		LocalAbilityStates.AddUnique(NewAbilityState);
 
-			if (NewAbilityInstance->IsAbilityActive())
-			{
-				NewAbilityInstance->CancelAbility(FDefaultTags::AbilityCancelled(), FInstancedStruct());
-			}
-			
-			NewAbilityInstance->InitializeAbility(this, NewAbilityState.AbilityID, true);
-			NewAbilityInstance->ActivateAbility(NewAbilityState.AbilityID, NewAbilityState.ActivationContext);
+		if (NewAbilityState.AbilityStatus != ActivationSuccess && NewAbilityState.AbilityStatus != EndedSuccessfully)
+		{
 			return;
 		}
 
-		FAbilityState& LocalState = LocalAbilityStates[LocalStateArrayIndexMap[NewAbilityState.AbilityID]];
-		CompareSnapshots(NewAbilityState, LocalState);
+		ClientActivateAbilityFromState(NewAbilityState, false);
+		return;
 	}
 
 	// Added a new attribute state
 	if (NewAbilityState.AbilityClass->IsChildOf(USimpleAttributeModifier::StaticClass()))
 	{
-		for (int32 i = 0; i < LocalAttributeStates.Num(); i++)
+		if (!GetAttributeState(NewAbilityState.AbilityID, false))
 		{
-			LocalStateArrayIndexMap.Add(LocalAttributeStates[i].AbilityID, i);
+			LocalAttributeStates.Add(NewAbilityState);
 		}
 
-		// If the NewAbilityState doesn't exist locally, we create a state and apply side effects if the state history is not empty
-		if (!LocalStateArrayIndexMap.Contains(NewAbilityState.AbilityID))
+		// The payload replicated before the state, now that we know the modifier class we can apply it
+		if (PendingStatePayloads.Remove(NewAbilityState.AbilityID) > 0)
 		{
-			LocalAttributeStates.Add(NewAbilityState);
-
-			if (NewAbilityState.SnapshotHistory.Num() > 0)
+			if (const FAbilityStatePayload* AuthorityPayload = GetAttributeStatePayload(NewAbilityState.AbilityID, true))
 			{
-				USimpleAttributeModifier* Modifier = GetAttributeModifierInstance(NewAbilityState.AbilityID);
-
-				if (!Modifier)
-				{
-					UClass* ParentClassPtr = NewAbilityState.AbilityClass.Get();
-					const TSubclassOf<USimpleAttributeModifier> AbilityClass = Cast<UClass>(ParentClassPtr);
-					Modifier = NewObject<USimpleAttributeModifier>(this, AbilityClass);
-					InstancedAttributes.Add(Modifier);
-				}
-
-				Modifier->InitializeAbility(this, NewAbilityState.AbilityID, true);
-
-				if (Modifier->ModifierApplicationPolicy == EAttributeModifierApplicationPolicy::ApplyClientPredicted)
-				{
-					return;
-				}
-				
-				Modifier->ClientFastForwardState(NewAbilityState.SnapshotHistory.Last().SnapshotTag, NewAbilityState.SnapshotHistory.Last());
+				OnAttributeStatePayloadAdded(*AuthorityPayload);
 			}
 		}
-		
 	}
 }
 
@@ -1033,127 +2343,244 @@ void USimpleGameplayAbilityComponent::OnStateChanged(const FAbilityState& Author
 	{
 		return;
 	}
-	
+
 	if (!AuthorityAbilityState.AbilityClass)
 	{
 		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::OnStateChanged]: Changed ability state with ID %s has an invalid class upon replication."), *AuthorityAbilityState.AbilityID.ToString()));
 		return;
 	}
-	
-	// Changed an ability state
-	if (AuthorityAbilityState.AbilityClass->IsChildOf(USimpleGameplayAbility::StaticClass()))
-	{
-		// Get a reference to the local version of the changed ability on the server
-		FAbilityState* LocalAbilityState = LocalAbilityStates.FindByPredicate([AuthorityAbilityState](const FAbilityState& AbilityState)
-		{
-			return AbilityState.AbilityID == AuthorityAbilityState.AbilityID;
-		});
-
-		// If the ability doesn't exist locally, we don't need to do anything
-		// Unless the ability we got from the server is still running
-		if (!LocalAbilityState)
-		{
-			// Avoid activating ServerOnly abilities on the client
-			if (AuthorityAbilityState.AbilityStatus != ActivationSuccess)
-			{
-				return;
-			}
 
-			if (AuthorityAbilityState.ActivationPolicy == EAbilityActivationPolicy::ServerOnly)
-			{
-				return;
-			}
-			
-			const TSubclassOf<USimpleGameplayAbility> AbilityClass = static_cast<TSubclassOf<USimpleGameplayAbility>>(AuthorityAbilityState.AbilityClass);
+	// Attribute state changes only carry a new status, snapshots are handled in OnAttributeStatePayloadChanged
+	if (!AuthorityAbilityState.AbilityClass->IsChildOf(USimpleGameplayAbility::StaticClass()))
+	{
+		return;
+	}
 
-			LocalAbilityStates.AddUnique(AuthorityAbilityState);
-			USimpleGameplayAbility* NewAbilityInstance = GetAbilityInstance(AbilityClass);
+	// Get a reference to the local version of the changed ability on the server
+	FAbilityState* LocalAbilityState = GetAbilityState(AuthorityAbilityState.AbilityID, false);
 
-			if (NewAbilityInstance->IsAbilityActive())
-			{
-				NewAbilityInstance->CancelAbility(FDefaultTags::AbilityCancelled(), FInstancedStruct(), true);
-			}
-		
-			NewAbilityInstance->InitializeAbility(this, AuthorityAbilityState.AbilityID, true);
-			NewAbilityInstance->ActivateAbility(AuthorityAbilityState.AbilityID, AuthorityAbilityState.ActivationContext);
+	// If the ability doesn't exist locally, we don't need to do anything
+	// Unless the ability we got from the server is still running
+	if (!LocalAbilityState)
+	{
+		// Avoid activating ServerOnly abilities on the client
+		if (AuthorityAbilityState.AbilityStatus != ActivationSuccess)
+		{
 			return;
 		}
 
-		// Check if the latest SnapshotHistory of the ability has changed
-		if (AuthorityAbilityState.SnapshotHistory.Num() > 0)
-		{
-			CompareSnapshots(AuthorityAbilityState, *LocalAbilityState);
-		}
-		
-		// Check if the server cancelled the ability
-		if (AuthorityAbilityState.AbilityStatus == EndedCancelled && LocalAbilityState->AbilityStatus != EndedCancelled)
+		if (AuthorityAbilityState.ActivationPolicy == EAbilityActivationPolicy::ServerOnly)
 		{
-			CancelAbility(AuthorityAbilityState.AbilityID, AuthorityAbilityState.EndingContext, true);
+			return;
 		}
+
+		LocalAbilityStates.AddUnique(AuthorityAbilityState);
+		ClientActivateAbilityFromState(AuthorityAbilityState, true);
+		return;
 	}
 
-	// Changed an attribute state
-	if (AuthorityAbilityState.AbilityClass->IsChildOf(USimpleAttributeModifier::StaticClass()))
+	// Check if the server cancelled the ability
+	if (AuthorityAbilityState.AbilityStatus == EndedCancelled && LocalAbilityState->AbilityStatus != EndedCancelled)
 	{
-		if (AuthorityAbilityState.SnapshotHistory.Num() > 0)
-		{
-			USimpleAttributeModifier* Modifier = GetAttributeModifierInstance(AuthorityAbilityState.AbilityID);
-
-			if (!Modifier)
-			{
-				return;
-			}
+		PendingStatePayloads.Remove(AuthorityAbilityState.AbilityID);
 
-			TArray<FSimpleAbilitySnapshot>* LocalSnapshots = GetLocalAttributeStateSnapshots(AuthorityAbilityState.AbilityID);
-
-			if (!LocalSnapshots)
-			{
-				SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::OnStateChanged]: Attribute modifier with ID %s not found in LocalAttributeStates array"), *AuthorityAbilityState.AbilityID.ToString()));
-				return;
-			}
-			
-			for (FSimpleAbilitySnapshot& LocalSnapshot : *LocalSnapshots)
-			{
-				if (LocalSnapshot.SnapshotTag == AuthorityAbilityState.SnapshotHistory.Last().SnapshotTag && !LocalSnapshot.WasClientSnapshotResolved)
-				{
-					Modifier->ClientResolvePastState(AuthorityAbilityState.SnapshotHistory.Last().SnapshotTag, AuthorityAbilityState.SnapshotHistory.Last(), LocalSnapshot);
-					LocalSnapshot.WasClientSnapshotResolved = true;
-					break;
-				}
-			}
-		}	
+		const FAbilityStatePayload* AuthorityPayload = GetAbilityStatePayload(AuthorityAbilityState.AbilityID, true);
+		CancelAbility(AuthorityAbilityState.AbilityID, AuthorityPayload ? AuthorityPayload->EndingContext : FInstancedStruct(), true);
 	}
 }
-  
+
 void USimpleGameplayAbilityComponent::OnStateRemoved(const FAbilityState& RemovedAbilityState)
 {
+	PendingStatePayloads.Remove(RemovedAbilityState.AbilityID);
+
 	if (RemovedAbilityState.AbilityClass->IsChildOf(USimpleGameplayAbility::StaticClass()))
 	{
 		LocalAbilityStates.RemoveAll([RemovedAbilityState](const FAbilityState& AbilityState) { return AbilityState.AbilityID == RemovedAbilityState.AbilityID; });
+		LocalAbilityStatePayloads.RemoveAll([RemovedAbilityState](const FAbilityStatePayload& Payload) { return Payload.AbilityID == RemovedAbilityState.AbilityID; });
 		return;
 	}
 
 	if (RemovedAbilityState.AbilityClass->IsChildOf(USimpleAttributeModifier::StaticClass()))
 	{
 		LocalAttributeStates.RemoveAll([RemovedAbilityState](const FAbilityState& AbilityState) { return AbilityState.AbilityID == RemovedAbilityState.AbilityID; });
+		LocalAttributeStatePayloads.RemoveAll([RemovedAbilityState](const FAbilityStatePayload& Payload) { return Payload.AbilityID == RemovedAbilityState.AbilityID; });
 	}
 }
 
-void USimpleGameplayAbilityComponent::CompareSnapshots(const FAbilityState& AuthorityAbilityState, FAbilityState& LocalAbilityState)
+void USimpleGameplayAbilityComponent::OnAbilityStatePayloadAdded(const FAbilityStatePayload& NewPayload)
 {
-	if (AuthorityAbilityState.SnapshotHistory.Num() == 0)
+	if (HasAuthority())
 	{
 		return;
 	}
-	
-	const FSimpleAbilitySnapshot& AuthoritySnapshot = AuthorityAbilityState.SnapshotHistory.Last();
-        
+
+	// The ability state replicated before its activation context, now we can activate it
+	if (PendingStatePayloads.Remove(NewPayload.AbilityID) > 0)
+	{
+		if (const FAbilityState* AuthorityAbilityState = GetAbilityState(NewPayload.AbilityID, true))
+		{
+			ClientActivateAbilityFromState(*AuthorityAbilityState, false);
+		}
+
+		return;
+	}
+
+	OnAbilityStatePayloadChanged(NewPayload);
+}
+
+void USimpleGameplayAbilityComponent::OnAbilityStatePayloadChanged(const FAbilityStatePayload& AuthorityPayload)
+{
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	// Check if the latest snapshot of the ability has changed. Only predicted abilities have local snapshots to compare against.
+	if (AuthorityPayload.SnapshotHistory.Num() == 0)
+	{
+		return;
+	}
+
+	if (FAbilityStatePayload* LocalPayload = GetAbilityStatePayload(AuthorityPayload.AbilityID, false))
+	{
+		CompareSnapshots(AuthorityPayload, *LocalPayload);
+	}
+}
+
+void USimpleGameplayAbilityComponent::OnAttributeStatePayloadAdded(const FAbilityStatePayload& NewPayload)
+{
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	if (NewPayload.SnapshotHistory.Num() == 0)
+	{
+		return;
+	}
+
+	// The client predicted this modifier, so we resolve our snapshots instead of fast forwarding
+	if (GetAttributeStatePayload(NewPayload.AbilityID, false))
+	{
+		ClientResolveAttributeModifierSnapshots(NewPayload);
+		return;
+	}
+
+	const FAbilityState* AuthorityAttributeState = GetAttributeState(NewPayload.AbilityID, true);
+
+	if (!AuthorityAttributeState)
+	{
+		PendingStatePayloads.Add(NewPayload.AbilityID);
+		return;
+	}
+
+	ClientFastForwardAttributeModifier(*AuthorityAttributeState, NewPayload);
+}
+
+void USimpleGameplayAbilityComponent::OnAttributeStatePayloadChanged(const FAbilityStatePayload& AuthorityPayload)
+{
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	if (AuthorityPayload.SnapshotHistory.Num() > 0)
+	{
+		ClientResolveAttributeModifierSnapshots(AuthorityPayload);
+	}
+}
+
+void USimpleGameplayAbilityComponent::ClientActivateAbilityFromState(const FAbilityState& AuthorityAbilityState, const bool ForceCancelRunningInstance)
+{
+	const FAbilityStatePayload* AuthorityPayload = GetAbilityStatePayload(AuthorityAbilityState.AbilityID, true);
+
+	// Wait for the activation context to replicate before activating the ability
+	if (AuthorityAbilityState.HasActivationContext && !AuthorityPayload)
+	{
+		PendingStatePayloads.Add(AuthorityAbilityState.AbilityID);
+		return;
+	}
+
+	const TSubclassOf<USimpleGameplayAbility> AbilityClass = static_cast<TSubclassOf<USimpleGameplayAbility>>(AuthorityAbilityState.AbilityClass);
+	USimpleGameplayAbility* NewAbilityInstance = GetAbilityInstance(AbilityClass);
+
+	if (NewAbilityInstance->IsAbilityActive())
+	{
+		NewAbilityInstance->CancelAbility(FDefaultTags::AbilityCancelled(), FInstancedStruct(), ForceCancelRunningInstance);
+	}
+
+	NewAbilityInstance->InitializeAbility(this, AuthorityAbilityState.AbilityID, true);
+	NewAbilityInstance->ActivateAbility(AuthorityAbilityState.AbilityID, AuthorityPayload ? AuthorityPayload->ActivationContext : FInstancedStruct());
+}
+
+void USimpleGameplayAbilityComponent::ClientFastForwardAttributeModifier(const FAbilityState& AuthorityAttributeState, const FAbilityStatePayload& AuthorityPayload)
+{
+	USimpleAttributeModifier* Modifier = GetAttributeModifierInstance(AuthorityAttributeState.AbilityID);
+
+	if (!Modifier)
+	{
+		UClass* ParentClassPtr = AuthorityAttributeState.AbilityClass.Get();
+		const TSubclassOf<USimpleAttributeModifier> AbilityClass = Cast<UClass>(ParentClassPtr);
+		Modifier = AcquireAttributeModifier(AbilityClass);
+	}
+
+	Modifier->InitializeAbility(this, AuthorityAttributeState.AbilityID, true);
+
+	if (Modifier->ModifierApplicationPolicy != EAttributeModifierApplicationPolicy::ApplyClientPredicted)
+	{
+		Modifier->ClientFastForwardState(AuthorityPayload.SnapshotHistory.Last().SnapshotTag, AuthorityPayload.SnapshotHistory.Last());
+	}
+
+	// Proxy modifiers only replay side effects, they don't stay applied
+	if (!Modifier->IsModifierActive())
+	{
+		ReleaseAttributeModifier(Modifier);
+	}
+}
+
+void USimpleGameplayAbilityComponent::ClientResolveAttributeModifierSnapshots(const FAbilityStatePayload& AuthorityPayload)
+{
+	USimpleAttributeModifier* Modifier = GetAttributeModifierInstance(AuthorityPayload.AbilityID);
+
+	if (!Modifier)
+	{
+		return;
+	}
+
+	TArray<FSimpleAbilitySnapshot>* LocalSnapshots = GetLocalAttributeStateSnapshots(AuthorityPayload.AbilityID);
+
+	if (!LocalSnapshots)
+	{
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::ClientResolveAttributeModifierSnapshots]: Attribute modifier with ID %s not found in LocalAttributeStatePayloads array"), *AuthorityPayload.AbilityID.ToString()));
+		return;
+	}
+
+	for (FSimpleAbilitySnapshot& LocalSnapshot : *LocalSnapshots)
+	{
+		if (LocalSnapshot.SnapshotTag == AuthorityPayload.SnapshotHistory.Last().SnapshotTag && !LocalSnapshot.WasClientSnapshotResolved)
+		{
+			Modifier->ClientResolvePastState(AuthorityPayload.SnapshotHistory.Last().SnapshotTag, AuthorityPayload.SnapshotHistory.Last(), LocalSnapshot);
+			LocalSnapshot.WasClientSnapshotResolved = true;
+			break;
+		}
+	}
+}
+
+void USimpleGameplayAbilityComponent::CompareSnapshots(const FAbilityStatePayload& AuthorityPayload, FAbilityStatePayload& LocalPayload)
+{
+	if (AuthorityPayload.SnapshotHistory.Num() == 0)
+	{
+		return;
+	}
+
+	const FSimpleAbilitySnapshot& AuthoritySnapshot = AuthorityPayload.SnapshotHistory.Last();
+
 	// Try to find matching snapshot by sequence number first
 	FSimpleAbilitySnapshot* MatchingSnapshot = nullptr;
-        
-	for (FSimpleAbilitySnapshot& ClientSnapshot : LocalAbilityState.SnapshotHistory)
+
+	for (FSimpleAbilitySnapshot& ClientSnapshot : LocalPayload.SnapshotHistory)
 	{
-		if (ClientSnapshot.SnapshotTag == AuthoritySnapshot.SnapshotTag && 
+		if (ClientSnapshot.SnapshotTag == AuthoritySnapshot.SnapshotTag &&
 			ClientSnapshot.SequenceNumber == AuthoritySnapshot.SequenceNumber &&
 			!ClientSnapshot.WasClientSnapshotResolved)
 		{
@@ -1161,13 +2588,13 @@ void USimpleGameplayAbilityComponent::CompareSnapshots(const FAbilityState& Auth
 			break;
 		}
 	}
-        
+
 	// Fall back to just matching by tag if sequence matching fails
 	if (!MatchingSnapshot)
 	{
-		for (FSimpleAbilitySnapshot& ClientSnapshot : LocalAbilityState.SnapshotHistory)
+		for (FSimpleAbilitySnapshot& ClientSnapshot : LocalPayload.SnapshotHistory)
 		{
-			if (ClientSnapshot.SnapshotTag == AuthoritySnapshot.SnapshotTag && 
+			if (ClientSnapshot.SnapshotTag == AuthoritySnapshot.SnapshotTag &&
 				!ClientSnapshot.WasClientSnapshotResolved)
 			{
 				MatchingSnapshot = &ClientSnapshot;
@@ -1176,8 +2603,8 @@ void USimpleGameplayAbilityComponent::CompareSnapshots(const FAbilityState& Auth
 		}
 	}
 
-	USimpleGameplayAbility* AbilityInstance = GetGameplayAbilityInstance(AuthorityAbilityState.AbilityID);
-			
+	USimpleGameplayAbility* AbilityInstance = GetGameplayAbilityInstance(AuthorityPayload.AbilityID);
+
 	if (MatchingSnapshot && AbilityInstance)
 	{
 		AbilityInstance->ClientResolvePastState(AuthoritySnapshot.SnapshotTag, AuthoritySnapshot, *MatchingSnapshot);
@@ -1185,54 +2612,117 @@ void USimpleGameplayAbilityComponent::CompareSnapshots(const FAbilityState& Auth
 	}
 }
 
-void USimpleGameplayAbilityComponent::OnGameplayTagAdded(const FGameplayTagCounter& GameplayTag)
+void USimpleGameplayAbilityComponent::OnGameplayTagsAdded(const FGameplayTagCounterContainer& Container, const TArrayView<int32>& AddedIndices)
 {
-	FGameplayTagCounter* LocalTagCounter = LocalGameplayTags.FindByPredicate(
-		[GameplayTag](const FGameplayTagCounter& TagCounter)
+	for (const int32 Index : AddedIndices)
+	{
+		const FGameplayTagCounter& TagCounter = Container.Tags[Index];
+		const int32 PredictedIndex = PredictedGameplayTags.IndexOfByKey(TagCounter);
+
+		// A tag removed earlier in this update hasn't sent its removed event yet, so listeners still think it's active
+		bool WasActive = PendingRemovedGameplayTags.RemoveTag(TagCounter.GameplayTag);
+
+		// The server's count replaces whatever the client predicted
+		if (PredictedIndex != INDEX_NONE)
 		{
-			return TagCounter.GameplayTag.MatchesTagExact(GameplayTag.GameplayTag);
-		});
+			WasActive = PredictedGameplayTags[PredictedIndex].ReferenceCounter > 0;
+			PredictedGameplayTags.RemoveAtSwap(PredictedIndex);
+		}
 
-	if (!LocalTagCounter)
-	{
-		LocalGameplayTags.AddUnique(GameplayTag);
-		SendEvent(FDefaultTags::GameplayTagAdded(), GameplayTag.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
-		return;
+		if (!WasActive && TagCounter.ReferenceCounter > 0)
+		{
+			SendEvent(FDefaultTags::GameplayTagAdded(), TagCounter.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
+		}
 	}
+}
 
-	LocalTagCounter->ReferenceCounter = GameplayTag.ReferenceCounter;
+void USimpleGameplayAbilityComponent::OnGameplayTagsChanged(const FGameplayTagCounterContainer& Container, const TArrayView<int32>& ChangedIndices)
+{
+	for (const int32 Index : ChangedIndices)
+	{
+		const FGameplayTagCounter& TagCounter = Container.Tags[Index];
+		const int32 PredictedIndex = PredictedGameplayTags.IndexOfByKey(TagCounter);
+
+		if (PredictedIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		// Only a predicted removal changes whether the tag is active, the count itself isn't sent as an event
+		const bool WasActive = PredictedGameplayTags[PredictedIndex].ReferenceCounter > 0;
+		PredictedGameplayTags.RemoveAtSwap(PredictedIndex);
+
+		if (!WasActive && TagCounter.ReferenceCounter > 0)
+		{
+			SendEvent(FDefaultTags::GameplayTagAdded(), TagCounter.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
+		}
+	}
 }
 
-void USimpleGameplayAbilityComponent::OnGameplayTagChanged(const FGameplayTagCounter& GameplayTag)
+void USimpleGameplayAbilityComponent::OnGameplayTagsRemoved(const FGameplayTagCounterContainer& Container, const TArrayView<int32>& RemovedIndices)
 {
-	FGameplayTagCounter* LocalTagCounter = LocalGameplayTags.FindByPredicate(
-		[GameplayTag](const FGameplayTagCounter& TagCounter)
+	for (const int32 Index : RemovedIndices)
+	{
+		const FGameplayTagCounter& TagCounter = Container.Tags[Index];
+		const int32 PredictedIndex = PredictedGameplayTags.IndexOfByKey(TagCounter);
+		bool WasActive = true;
+
+		if (PredictedIndex != INDEX_NONE)
 		{
-			return TagCounter.GameplayTag.MatchesTagExact(GameplayTag.GameplayTag);
-		});
+			WasActive = PredictedGameplayTags[PredictedIndex].ReferenceCounter > 0;
+			PredictedGameplayTags.RemoveAtSwap(PredictedIndex);
+		}
+
+		if (WasActive)
+		{
+			PendingRemovedGameplayTags.AddTag(TagCounter.GameplayTag);
+		}
+	}
+}
+
+void USimpleGameplayAbilityComponent::OnAbilityCooldownAdded(const FAbilityCooldown& NewCooldown)
+{
+	OnAbilityCooldownChanged(NewCooldown);
+}
 
-	if (!LocalTagCounter)
+void USimpleGameplayAbilityComponent::OnAbilityCooldownChanged(const FAbilityCooldown& ChangedCooldown)
+{
+	if (HasAuthority())
 	{
-		LocalGameplayTags.AddUnique(GameplayTag);
-		SendEvent(FDefaultTags::GameplayTagAdded(), GameplayTag.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
 		return;
 	}
 
-	LocalTagCounter->ReferenceCounter = GameplayTag.ReferenceCounter;
+	// The server version always wins over a predicted cooldown
+	FAbilityCooldown* LocalCooldown = FindCooldown(ChangedCooldown.AbilityClass, ChangedCooldown.CooldownTag);
+
+	if (!LocalCooldown)
+	{
+		FAbilityCooldown NewCooldown;
+		NewCooldown.CooldownTag = ChangedCooldown.CooldownTag;
+		LocalAbilityCooldowns.Add(NewCooldown);
+		LocalCooldown = &LocalAbilityCooldowns.Last();
+	}
+
+	LocalCooldown->AbilityClass = ChangedCooldown.AbilityClass;
+	LocalCooldown->CooldownEndTime = ChangedCooldown.CooldownEndTime;
+	LocalCooldown->CooldownDuration = ChangedCooldown.CooldownDuration;
+
+	ScheduleCooldownExpiry(*LocalCooldown);
 }
 
-void USimpleGameplayAbilityComponent::OnGameplayTagRemoved(const FGameplayTagCounter& GameplayTag)
+void USimpleGameplayAbilityComponent::OnAbilityCooldownRemoved(const FAbilityCooldown& RemovedCooldown)
 {
-	FGameplayTagCounter* LocalTagCounter = LocalGameplayTags.FindByPredicate(
-		[GameplayTag](const FGameplayTagCounter& TagCounter)
-		{
-			return TagCounter.GameplayTag.MatchesTagExact(GameplayTag.GameplayTag);
-		});
+	if (HasAuthority())
+	{
+		return;
+	}
+
+	const FAbilityCooldown* LocalCooldown = FindCooldown(RemovedCooldown.AbilityClass, RemovedCooldown.CooldownTag);
 
-	if (LocalTagCounter)
+	// Keep the local cooldown if the client predicted a newer one
+	if (LocalCooldown && LocalCooldown->CooldownEndTime <= RemovedCooldown.CooldownEndTime)
 	{
-		LocalGameplayTags.RemoveSingle(GameplayTag);
-		SendEvent(FDefaultTags::GameplayTagRemoved(), GameplayTag.GameplayTag, FInstancedStruct(), this, {}, ESimpleEventReplicationPolicy::NoReplication);
+		RemoveCooldown(RemovedCooldown.AbilityClass, RemovedCooldown.CooldownTag, true);
 	}
 }
 
@@ -1240,14 +2730,77 @@ void USimpleGameplayAbilityComponent::GetLifetimeReplicatedProps(TArray<class FL
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, AvatarActor);
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, AuthorityGameplayTags);
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, GrantedAbilities);
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, ActiveAbilityOverrides);
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, AuthorityFloatAttributes);
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, AuthorityStructAttributes);
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, AuthorityAbilityStates);
-	DOREPLIFETIME(USimpleGameplayAbilityComponent, AuthorityAttributeStates);
+	// Everything is push based so idle components aren't compared every net update
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AvatarActor, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityGameplayTags, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, GrantedAbilities, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, ActivatableAbilityClasses, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, ActiveAbilityOverrides, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityFloatAttributes, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityStructAttributes, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityAbilityStates, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityAttributeStates, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityAbilityStatePayloads, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityAttributeStatePayloads, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityAbilityCooldowns, Params);
+
+	Params.Condition = COND_OwnerOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityOwnerOnlyFloatAttributes, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthorityOwnerOnlyStructAttributes, Params);
+
+	Params.Condition = COND_SimulatedOnly;
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthoritySimulatedOnlyFloatAttributes, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(USimpleGameplayAbilityComponent, AuthoritySimulatedOnlyStructAttributes, Params);
+}
+
+void USimpleGameplayAbilityComponent::MarkContainerDirty(FFastArraySerializer& Container)
+{
+	Container.MarkArrayDirty();
+	MarkContainerPropertyDirty(Container);
+}
+
+void USimpleGameplayAbilityComponent::MarkContainerItemDirty(FFastArraySerializer& Container, FFastArraySerializerItem& Item)
+{
+	Container.MarkItemDirty(Item);
+	MarkContainerPropertyDirty(Container);
+}
+
+void USimpleGameplayAbilityComponent::MarkContainerPropertyDirty(const FFastArraySerializer& Container)
+{
+	// Unreplicated attributes never need a net update
+	if (&Container == &AuthorityUnreplicatedFloatAttributes || &Container == &AuthorityUnreplicatedStructAttributes)
+	{
+		return;
+	}
+	
+	NotifyReplicatedStateChanged();
+	
+#if WITH_PUSH_MODEL
+#define SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(PropertyName) \
+	if (&Container == &PropertyName) \
+	{ \
+		MARK_PROPERTY_DIRTY_FROM_NAME(USimpleGameplayAbilityComponent, PropertyName, this); \
+		return; \
+	}
+
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityGameplayTags)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityFloatAttributes)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityOwnerOnlyFloatAttributes)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthoritySimulatedOnlyFloatAttributes)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityStructAttributes)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityOwnerOnlyStructAttributes)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthoritySimulatedOnlyStructAttributes)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityAbilityStates)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityAttributeStates)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityAbilityStatePayloads)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityAttributeStatePayloads)
+	SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY(AuthorityAbilityCooldowns)
+
+#undef SIMPLE_MARK_CONTAINER_PROPERTY_DIRTY
+#endif
 }
 
 
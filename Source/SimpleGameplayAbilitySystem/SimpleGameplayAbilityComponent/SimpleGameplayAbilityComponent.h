@@ -4,6 +4,7 @@
 #include "GameplayTagContainer.h"
 #include "SimpleAbilityComponentTypes.h"
 #include "Components/ActorComponent.h"
+#include "Containers/Queue.h"
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAbilityTypes.h"
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleGameplayAbility/SimpleGameplayAbility.h"
 #include "SimpleGameplayAbilityComponent.generated.h"
@@ -14,6 +15,8 @@ class UAbilityOverrideSet;
 class UAbilitySet;
 class UAttributeSet;
 class USimpleGameplayAbility;
+class USimpleNetworkClockComponent;
+class USimpleEventRelevancyPolicy;
 
 UCLASS(Blueprintable, ClassGroup=(AbilityComponent), meta=(BlueprintSpawnableComponent))
 class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleGameplayAbilityComponent : public UActorComponent
@@ -39,6 +42,11 @@ public:
 	
 	UPROPERTY(EditAnywhere, Replicated, BlueprintReadOnly, Category = "AbilityComponent|Abilities")
 	TArray<TSubclassOf<USimpleGameplayAbility>> GrantedAbilities;
+
+	// Every ability class that has been granted, in the order it was granted. Clients send an ability's index in here
+	// instead of its class when activating it. Entries are never removed so indices stay valid for in-flight requests.
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State")
+	TArray<TSubclassOf<USimpleGameplayAbility>> ActivatableAbilityClasses;
 	
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AbilityComponent|Attributes")
 	TArray<UAttributeSet*> AttributeSets;
@@ -48,15 +56,29 @@ public:
 	UPROPERTY(EditDefaultsOnly, Category = "AbilityComponent|Attributes", meta = (TitleProperty = "AttributeName"))
 	TArray<FStructAttribute> StructAttributes;
 	
+	// Attributes are split by their replication scope. AuthorityFloatAttributes holds the ones replicated to everyone.
 	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
 	FFloatAttributeContainer AuthorityFloatAttributes;
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
+	FFloatAttributeContainer AuthorityOwnerOnlyFloatAttributes;
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
+	FFloatAttributeContainer AuthoritySimulatedOnlyFloatAttributes;
+	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
+	FFloatAttributeContainer AuthorityUnreplicatedFloatAttributes;
+	// Clients only keep the attributes they changed locally. They're dropped when the server sends the attribute again.
 	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State", meta = (TitleProperty = "AttributeName"))
-	TArray<FFloatAttribute> LocalFloatAttributes;
+	TArray<FFloatAttribute> PredictedFloatAttributes;
 	
 	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
 	FStructAttributeContainer AuthorityStructAttributes;
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
+	FStructAttributeContainer AuthorityOwnerOnlyStructAttributes;
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
+	FStructAttributeContainer AuthoritySimulatedOnlyStructAttributes;
+	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State", meta = (TitleProperty = "Attributes.AttributeName"))
+	FStructAttributeContainer AuthorityUnreplicatedStructAttributes;
 	UPROPERTY(VisibleAnywhere, meta = (TitleProperty = "AttributeName"), Category = "AbilityComponent|State")
-	TArray<FStructAttribute> LocalStructAttributes;
+	TArray<FStructAttribute> PredictedStructAttributes;
 	
 	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "AbilityStates.AbilityClass"))
 	FAbilityStateContainer AuthorityAbilityStates;
@@ -68,13 +90,94 @@ public:
 	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State", meta = (TitleProperty = "AbilityClass"))
 	TArray<FAbilityState> LocalAttributeStates;
 
+	// Contexts and snapshots of the ability and attribute states above. Replicated separately so status changes stay small.
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State")
+	FAbilityStatePayloadContainer AuthorityAbilityStatePayloads;
+	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State")
+	TArray<FAbilityStatePayload> LocalAbilityStatePayloads;
+
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State")
+	FAbilityStatePayloadContainer AuthorityAttributeStatePayloads;
+	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State")
+	TArray<FAbilityStatePayload> LocalAttributeStatePayloads;
+
+	/**
+	 * How many ended attribute modifiers of each class are kept for reuse. When a pool is full, the modifier that ended
+	 * first is left to be garbage collected.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Attributes", meta = (ClampMin = "0"))
+	int32 MaxPooledModifiersPerClass = 16;
+
+	/**
+	 * How many ended attribute modifiers keep their replicated state so clients that haven't received it yet can still
+	 * resolve their predictions. The state of the modifier that ended first is removed once there are more.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Attributes", meta = (ClampMin = "0"))
+	int32 MaxEndedModifierStates = 64;
+
+	/* Multiplies the base cooldown of every ability activated by this component. Use values below 1 for cooldown reduction. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Cooldowns")
+	float CooldownDurationMultiplier = 1.0f;
+
+	/**
+	 * How long (in seconds) we wait for the server or client echo of a replicated event before forgetting it.
+	 * Events that are handled locally are remembered so the echo doesn't trigger them a second time.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Events", meta = (ClampMin = "0"))
+	float HandledEventIDLifetime = 10.0f;
+
+	/* The maximum number of handled event IDs remembered at once. The oldest are forgotten first. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Events", meta = (ClampMin = "1"))
+	int32 MaxHandledEventIDs = 1024;
+
+	/**
+	 * If true, replicated events are queued and sent in a single RPC per frame instead of one reliable RPC per event.
+	 * Batched events send their compact ID instead of a full FGuid and skip empty listener filters.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Events")
+	bool BatchReplicatedEvents = true;
+
+	/**
+	 * The maximum number of times per second an event with this tag is replicated when using an unreliable replication policy.
+	 * Events over the limit are only handled on the machine that sends them and are never replicated.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Events", meta = (ForceInlineRow))
+	TMap<FGameplayTag, float> UnreliableEventRateLimits;
+
+	/**
+	 * The relevancy policy used for AllConnectedClients events with this tag when SendEvent isn't given one.
+	 * Events with a policy are only sent to the clients it picks instead of being multicast. This also applies to
+	 * events sent from clients, since they are relayed to the other clients by the server.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Events", meta = (ForceInlineRow))
+	TMap<FGameplayTag, TSubclassOf<USimpleEventRelevancyPolicy>> EventRelevancyPolicies;
+
+	/**
+	 * If true, the server makes the owning actor net dormant while this component is idle: no active abilities or
+	 * modifiers, nothing waiting to replicate and no replicated changes for IdleDormancyDelay seconds.
+	 * Any replicated change wakes the actor up again. Meant for NPCs with attributes that rarely change, don't use it
+	 * on actors owned by a client or actors with other properties that need to replicate while the component is idle.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Replication")
+	bool UseIdleNetDormancy = false;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Replication", meta = (ClampMin = "0", EditCondition = "UseIdleNetDormancy"))
+	float IdleDormancyDelay = 5.0f;
+
+	/**
+	 * If true, clients use the USimpleNetworkClockComponent on the local PlayerController in GetServerTime once it has
+	 * synced. Without one, or with this turned off, the game state's server time is used.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AbilityComponent|Replication")
+	bool UseNetworkClock = true;
+
 	/* Avatar Actor Functions */
 	
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|AvatarActor")
 	AActor* GetAvatarActor() const { return AvatarActor; }
 	
 	UFUNCTION(BlueprintCallable, BlueprintAuthorityOnly, Category = "AbilityComponent|AvatarActor")
-	void SetAvatarActor(AActor* NewAvatarActor) { AvatarActor = NewAvatarActor; }
+	void SetAvatarActor(AActor* NewAvatarActor);
 
 	UFUNCTION(BlueprintCallable, BlueprintPure)
 	bool IsAvatarActorOfType(TSubclassOf<AActor> AvatarClass) const;
@@ -101,6 +204,7 @@ public:
 		bool OverrideActivationPolicy,
 		EAbilityActivationPolicy ActivationPolicyOverride);
 
+	/* On clients a compact AbilityID is given the client prefix, IDs from MakeNetID already have it. */
 	bool ActivateAbilityWithID(
 		const FGuid AbilityID,
 		TSubclassOf<USimpleGameplayAbility> AbilityClass,
@@ -112,6 +216,27 @@ public:
 	void ServerActivateAbility(const FGuid AbilityID, TSubclassOf<USimpleGameplayAbility> AbilityClass,
 	                           const FInstancedStruct& AbilityContext, EAbilityActivationPolicy ActivationPolicy, float ActivationTime);
 
+	/**
+	 * Activates several abilities in one pass.
+	 * On clients, every ability that needs the server is sent in a single RPC instead of one ServerActivateAbility call per ability.
+	 * Useful for combo systems or AI that trigger many abilities in the same frame.
+	 * @param Requests The abilities to activate
+	 * @param AbilityIDs The ID used for each request, in the same order as Requests
+	 * @return The number of abilities that were activated (or sent to the server to be activated)
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|AbilityActivation")
+	int32 ActivateAbilities(const TArray<FSimpleAbilityActivationRequest>& Requests, TArray<FGuid>& AbilityIDs);
+
+	UFUNCTION(Server, Reliable)
+	void ServerActivateAbilities(const TArray<FSimpleAbilityActivationRequest>& Requests, float ActivationTime);
+
+	/* Used instead of ServerActivateAbility(ies) for abilities in ActivatableAbilityClasses. ActivationTime is quantized, see FSimpleAbilityActivationNetRequest. */
+	UFUNCTION(Server, Reliable)
+	void ServerActivateAbilityCompact(const FSimpleAbilityActivationNetRequest& Request, uint16 ActivationTime);
+
+	UFUNCTION(Server, Reliable)
+	void ServerActivateAbilitiesCompact(const TArray<FSimpleAbilityActivationNetRequest>& Requests, uint16 ActivationTime);
+
 	UFUNCTION(BlueprintCallable, meta=(AdvancedDisplay=2), Category = "AbilityComponent|AbilityActivation")
 	bool CancelAbility(FGuid AbilityInstanceID, FInstancedStruct CancellationContext, bool ForceCancel);
 
@@ -170,8 +295,19 @@ public:
 	UFUNCTION()
 	void ApplyAbilitySideEffects(USimpleGameplayAbilityComponent* Instigator, const TArray<FAbilitySideEffect>& AbilitySideEffects);
 
-	FFloatAttribute* GetFloatAttribute(FGameplayTag AttributeTag);
-	FStructAttribute* GetStructAttribute(FGameplayTag AttributeTag);
+	/* Returns the attribute as this machine sees it: the locally predicted one if there is one, otherwise the replicated one. */
+	const FFloatAttribute* GetFloatAttribute(FGameplayTag AttributeTag);
+	const FStructAttribute* GetStructAttribute(FGameplayTag AttributeTag);
+
+	/* Returns the attribute to write to. On clients the replicated attribute is copied into the prediction overlay first. */
+	FFloatAttribute* GetMutableFloatAttribute(FGameplayTag AttributeTag);
+	FStructAttribute* GetMutableStructAttribute(FGameplayTag AttributeTag);
+
+	FFloatAttribute* FindAuthorityFloatAttribute(FGameplayTag AttributeTag);
+	FStructAttribute* FindAuthorityStructAttribute(FGameplayTag AttributeTag);
+
+	/* Copies the authority attributes of every replication scope. On clients this only includes what was replicated to them. */
+	void CopyAuthorityAttributes(TArray<FFloatAttribute>& OutFloatAttributes, TArray<FStructAttribute>& OutStructAttributes) const;
 	
 	/* Attribute Modifier Functions */
 	
@@ -193,8 +329,24 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Attributes")
 	void CancelAttributeModifier(FGuid ModifierID);
 
+	/* Cancels every active modifier this component applied that has any of these tags, whichever component it was applied to. */
 	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Attributes")
 	void CancelAttributeModifiersWithTags(FGameplayTagContainer Tags);
+
+	/* Cancels every duration modifier active on this component that has any of these tags, whichever component applied it. */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Attributes")
+	void CancelActiveModifiersOnSelfWithTags(FGameplayTagContainer Tags);
+
+	/* Returns true if a duration modifier with any of these tags is active on this component. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Attributes")
+	bool HasActiveModifierWithTags(const FGameplayTagContainer& Tags) const;
+
+	/* Returns the duration modifier of this class that Instigator applied to this component, if it's still active. */
+	USimpleAttributeModifier* FindActiveModifierOfClass(const UClass* ModifierClass, const USimpleGameplayAbilityComponent* Instigator) const;
+
+	/* Called by duration modifiers when they start and stop affecting this component */
+	void RegisterActiveModifier(USimpleAttributeModifier* Modifier);
+	void UnregisterActiveModifier(USimpleAttributeModifier* Modifier);
 	
 	/* Gameplay Tag Functions */
 	
@@ -233,16 +385,64 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Tags")
 	FGameplayTagContainer GetActiveGameplayTags() const;
 	
+	/* Cooldown Functions */
+
+	/**
+	 * Starts (or restarts) the cooldown of an ability.
+	 * Abilities with a CooldownTag share their cooldown with every other ability that uses the same tag.
+	 * A cooldown ended event is sent once the cooldown runs out.
+	 * @param AbilityClass The ability to put on cooldown
+	 * @param Duration The cooldown duration in seconds. If negative, GetAbilityCooldownDuration is used.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Cooldowns", meta = (AdvancedDisplay=1))
+	void StartAbilityCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, float Duration = -1.0f);
+
+	/**
+	 * Adds time to a running cooldown. Use a negative value to reduce it.
+	 * If no time is left after the change the cooldown ends immediately.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Cooldowns")
+	void ModifyAbilityCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, float TimeDelta);
+
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Cooldowns")
+	void ModifyCooldownByTag(FGameplayTag CooldownTag, float TimeDelta);
+
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Cooldowns")
+	void ClearAbilityCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass);
+
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Cooldowns")
+	float GetCooldownTimeRemainingByTag(FGameplayTag CooldownTag);
+
+	/**
+	 * Returns how long the cooldown of an ability lasts when it gets activated.
+	 * By default returns the Cooldown of the ability multiplied by CooldownDurationMultiplier.
+	 * Override this function to calculate cooldowns from attributes (e.g. a cooldown reduction stat).
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintPure, Category = "AbilityComponent|Cooldowns")
+	float GetAbilityCooldownDuration(TSubclassOf<USimpleGameplayAbility> AbilityClass);
+	virtual float GetAbilityCooldownDuration_Implementation(TSubclassOf<USimpleGameplayAbility> AbilityClass);
+	
 	/* Replicated Event Functions */
 	
-	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Events", meta=(AutoCreateRefTerm = "ListenerFilter"))
+	/**
+	 * Sends an event through the SimpleEventSubsystem and replicates it according to ReplicationPolicy.
+	 * @param RelevancyPolicy Only used by AllConnectedClients events sent on the server. Picks which clients receive
+	 * the event instead of multicasting it. If not set, the policy in EventRelevancyPolicies for the EventTag is used.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Events", meta=(AutoCreateRefTerm = "ListenerFilter", AdvancedDisplay = "RelevancyPolicy"))
 	void SendEvent(
 		FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
-		UObject* Sender, TArray<UObject*> ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy);
+		UObject* Sender, TArray<UObject*> ListenerFilter, ESimpleEventReplicationPolicy ReplicationPolicy,
+		TSubclassOf<USimpleEventRelevancyPolicy> RelevancyPolicy = nullptr);
 	
+	/**
+	 * Sends an event through the SimpleEventSubsystem on this machine.
+	 * @param ExpectsEcho True if the event will be replicated back to us, the ID is remembered so the echo is skipped.
+	 */
 	void SendEventInternal(
 		FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload,
-		UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter);
+		UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter,
+		bool ExpectsEcho = false);
 
 	UFUNCTION(Server, Reliable)
 	void ServerSendEvent(
@@ -258,6 +458,46 @@ public:
 	void MulticastSendEvent(
 		FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
 		UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter);
+
+	UFUNCTION(Server, Unreliable)
+	void ServerSendEventUnreliable(
+		FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
+		UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter);
+
+	UFUNCTION(Client, Unreliable)
+	void ClientSendEventUnreliable(
+		FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
+		UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter);
+	
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastSendEventUnreliable(
+		FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, FInstancedStruct Payload,
+		UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSendEventBatch(const TArray<FReplicatedEventBatchEntry>& Events);
+
+	UFUNCTION(Client, Reliable)
+	void ClientSendEventBatch(const TArray<FReplicatedEventBatchEntry>& Events);
+
+	UFUNCTION(NetMulticast, Reliable)
+	void MulticastSendEventBatch(const TArray<FReplicatedEventBatchEntry>& Events);
+
+	UFUNCTION(Server, Unreliable)
+	void ServerSendEventBatchUnreliable(const TArray<FReplicatedEventBatchEntry>& Events);
+
+	UFUNCTION(Client, Unreliable)
+	void ClientSendEventBatchUnreliable(const TArray<FReplicatedEventBatchEntry>& Events);
+
+	UFUNCTION(NetMulticast, Unreliable)
+	void MulticastSendEventBatchUnreliable(const TArray<FReplicatedEventBatchEntry>& Events);
+
+	/**
+	 * Returns how many replicated events were handled locally but never received their server/client echo
+	 * before they expired or were pushed out by MaxHandledEventIDs. Useful for spotting dropped or misrouted events.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Events")
+	int32 GetUnconfirmedEventCount() const { return UnconfirmedEventCount; }
 	
 	/* Utility Functions */
 
@@ -284,7 +524,8 @@ public:
 	/**
 	 * Returns the server time if called on the server.
 	 * Returns the clients estimation of the server time if called on the client.
-	 * By default, uses GetWorld()->GetGameState()->GetServerWorldTimeSeconds() to get the server time.
+	 * By default, uses the local USimpleNetworkClockComponent if there is one (see UseNetworkClock) and
+	 * GetWorld()->GetGameState()->GetServerWorldTimeSeconds() otherwise.
 	 * Override this function to provide a custom network time synchronisation implementation.
 	 * @return The current server time in seconds
 	 */
@@ -292,7 +533,44 @@ public:
 	double GetServerTime();
 	virtual double GetServerTime_Implementation();
 
+	/**
+	 * Returns GetServerTime, evaluated at most once per frame on this component.
+	 * The ability system uses this internally so that an expensive GetServerTime override isn't run on every activation,
+	 * snapshot and cooldown check. Call InvalidateCachedServerTime if the clock changes mid-frame (e.g. after a clock resync).
+	 * @return The server time at the first call this frame
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Utility")
+	double GetCachedServerTime();
+
+	/* Forces the next GetCachedServerTime call to re-evaluate GetServerTime. */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Utility")
+	void InvalidateCachedServerTime();
+
+	/**
+	 * Makes a new ID for an ability, attribute modifier or event started from this component.
+	 * The ID is a compact 32 bit ID (see FSimpleNetID) stored in an FGuid, which is much smaller to send than a random FGuid.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "AbilityComponent|Utility")
+	FGuid MakeNetID() const;
+
+	/* True if no abilities or modifiers are active and nothing is waiting to be replicated. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Replication")
+	bool IsQuiescent() const;
+
+	/* True if the server made the owning actor dormant because this component was idle. See UseIdleNetDormancy. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "AbilityComponent|Replication")
+	bool IsIdleDormant() const { return IdleDormant; }
+
 	FAbilityState* GetAbilityState(FGuid AbilityID, bool IsAuthorityState);
+	FAbilityState* GetAttributeState(FGuid AttributeInstanceID, bool IsAuthorityState);
+
+	/**
+	 * Returns the payload (contexts and snapshots) of an ability or attribute state.
+	 * Payloads are only created when there is something to store in them, so this returns nullptr for most states
+	 * unless CreateIfMissing is true. A newly created authority payload is already marked dirty.
+	 */
+	FAbilityStatePayload* GetAbilityStatePayload(FGuid AbilityID, bool IsAuthorityState, bool CreateIfMissing = false);
+	FAbilityStatePayload* GetAttributeStatePayload(FGuid AttributeInstanceID, bool IsAuthorityState, bool CreateIfMissing = false);
 
 	UFUNCTION(BlueprintCallable, BlueprintPure, BlueprintCallable, Category = "AbilityComponent|Utility")
 	USimpleAttributeHandler* GetAttributeHandler(FGameplayTag AttributeTag);
@@ -307,9 +585,13 @@ public:
 
 	/* Called by multiple instance abilities to set themselves up for deletion once the ability is over */
 	void RemoveInstancedAbility(USimpleGameplayAbility* AbilityToRemove);
+
+	/* Called by attribute modifiers once they end to return themselves to the pool of their class */
+	void ReleaseAttributeModifier(USimpleAttributeModifier* ModifierToRelease);
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void PostRepNotifies() override;
 
 	UFUNCTION()
 	void OnAbilityEndedEventReceived(FGameplayTag EventTag, FGameplayTag Domain, FInstancedStruct Payload, UObject* Sender);
@@ -318,6 +600,16 @@ protected:
 	void OnAbilityEnded(FGuid AbilityID, FGameplayTag EndStatus, FInstancedStruct EndContext, bool WasCancelled);
 	virtual void OnAbilityEnded_Implementation(FGuid AbilityID, FGameplayTag EndStatus, FInstancedStruct EndContext, bool WasCancelled);
 	
+	bool ActivateAbilityWithPolicy(const FGuid AbilityID, TSubclassOf<USimpleGameplayAbility> AbilityClass,
+		const FInstancedStruct& AbilityContext, EAbilityActivationPolicy ActivationPolicy,
+		float ActivationTime, FSimpleAbilityActivationBatch* ServerRequestBatch = nullptr);
+
+	void AddActivatableAbilityClass(TSubclassOf<USimpleGameplayAbility> AbilityClass);
+	// Returns false if the ability can't be sent compactly, e.g. it was never granted or the game uses Iris
+	bool MakeActivationNetRequest(FGuid AbilityID, TSubclassOf<USimpleGameplayAbility> AbilityClass, const FInstancedStruct& AbilityContext,
+		EAbilityActivationPolicy ActivationPolicy, FSimpleAbilityActivationNetRequest& OutRequest) const;
+	void ActivateAbilityFromNetRequest(const FSimpleAbilityActivationNetRequest& Request, float ActivationTime);
+	
 	bool ActivateAbilityInternal(const FGuid AbilityID, TSubclassOf<USimpleGameplayAbility> AbilityClass,
 		const FInstancedStruct& AbilityContext, EAbilityActivationPolicy ActivationPolicy,
 		bool TrackState, float ActivationTime = -1);
@@ -333,47 +625,199 @@ protected:
 
 	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State")
 	FGameplayTagCounterContainer AuthorityGameplayTags;
+	// Tag counts clients predicted that differ from the replicated ones. A count of 0 means the tag was removed locally.
 	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State")
-	TArray<FGameplayTagCounter> LocalGameplayTags;
+	TArray<FGameplayTagCounter> PredictedGameplayTags;
+
+	const FGameplayTagCounter* FindGameplayTagCounter(FGameplayTag Tag) const;
+	void SetPredictedGameplayTagCount(FGameplayTag Tag, int32 ReferenceCounter);
+
+	UPROPERTY(VisibleAnywhere, Replicated, Category = "AbilityComponent|State", meta = (TitleProperty = "AbilityClass"))
+	FAbilityCooldownContainer AuthorityAbilityCooldowns;
+	UPROPERTY(VisibleAnywhere, Category = "AbilityComponent|State", meta = (TitleProperty = "AbilityClass"))
+	TArray<FAbilityCooldown> LocalAbilityCooldowns;
 	
 	USimpleGameplayAbility* GetGameplayAbilityInstance(FGuid AbilityInstanceID);
 	USimpleAttributeModifier* GetAttributeModifierInstance(FGuid AttributeInstanceID);
 	TArray<FSimpleAbilitySnapshot>* GetLocalAttributeStateSnapshots(FGuid AttributeInstanceID);
 	USimpleGameplayAbility* GetAbilityInstance(TSubclassOf<USimpleGameplayAbility> AbilityClass);
+	USimpleAttributeModifier* AcquireAttributeModifier(TSubclassOf<USimpleAttributeModifier> ModifierClass);
+	void RemoveOldEndedModifierStates();
 
 	UPROPERTY()
 	TArray<USimpleGameplayAbility*> InstancedAbilities;
 	
+	// Modifiers that are applied or waiting on their server state. Ended ones move to AttributeModifierPools.
 	UPROPERTY()
 	TArray<USimpleAttributeModifier*> InstancedAttributes;
 
+	// Ended modifiers keep their AbilityInstanceID until they're reused so late server snapshots can still be resolved against them.
+	// Each pool is ordered by when the modifiers ended and reuses the oldest first, the recently ended ones are the likeliest to get late snapshots.
+	UPROPERTY()
+	TMap<UClass*, FAttributeModifierList> AttributeModifierPools;
+
+	// Server only. IDs of the AuthorityAttributeStates whose modifier ended, in the order they ended.
+	TArray<FGuid> EndedModifierStateIDs;
+
+	// Duration modifiers currently applied to this component by any instigator, indexed by class and by each of their ModifierTags
+	UPROPERTY()
+	TMap<UClass*, FAttributeModifierList> ActiveModifiersByClass;
+	UPROPERTY()
+	TMap<FGameplayTag, FAttributeModifierList> ActiveModifiersByTag;
+
 	UPROPERTY()
 	TArray<USimpleAttributeHandler*> InstancedAttributeHandlers;
 	
 	// Used to keep track of which events have been handled locally to avoid double event sending with multicast
-	TArray<FGuid> HandledEventIDs;
+	TSet<FGuid> HandledEventIDs;
+	// The same IDs in the order they were handled, with the time they were handled. Used to expire old IDs.
+	// Confirmed IDs stay in the queue until they reach the front, so the queue size is what MaxHandledEventIDs caps.
+	TQueue<TPair<FGuid, double>> HandledEventIDQueue;
+	int32 HandledEventIDQueueNum = 0;
+	int32 UnconfirmedEventCount = 0;
 
-	// Used to keep track of the last time an ability was activated for checking cooldowns
-	TMap<TSubclassOf<USimpleGameplayAbility>, float> LastActivatedAbilityTimeStamps;
+	void AddHandledEventID(FGuid EventID);
+	void ExpireHandledEventIDs();
+
+	// Replicated events waiting to be sent in the next batch
+	UPROPERTY()
+	TArray<FReplicatedEventBatchEntry> PendingServerEvents;
+	UPROPERTY()
+	TArray<FReplicatedEventBatchEntry> PendingClientEvents;
+	UPROPERTY()
+	TArray<FReplicatedEventBatchEntry> PendingMulticastEvents;
+	UPROPERTY()
+	TArray<FReplicatedEventBatchEntry> PendingUnreliableServerEvents;
+	UPROPERTY()
+	TArray<FReplicatedEventBatchEntry> PendingUnreliableClientEvents;
+	UPROPERTY()
+	TArray<FReplicatedEventBatchEntry> PendingUnreliableMulticastEvents;
+
+	// The last time an unreliable event with a rate limited tag was replicated
+	TMap<FGameplayTag, double> LastUnreliableEventTimes;
+
+	FDelegateHandle EventBatchFlushHandle;
+
+	// So a PlayerController without a USimpleEventRelayComponent is only warned about once per component
+	bool HasWarnedAboutMissingEventRelay = false;
+	
+	// Sends the event RPC to the target, or queues it if batching is on and the event has a compact ID
+	void DispatchReplicatedEvent(
+		EReplicatedEventTarget Target, FGuid EventID, FGameplayTag EventTag, FGameplayTag DomainTag, const FInstancedStruct& Payload,
+		UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy, const TArray<UObject*>& ListenerFilter,
+		TSubclassOf<USimpleEventRelevancyPolicy> RelevancyPolicy = nullptr);
+	// Sends an AllClients event to each client the policy finds it relevant to, through their USimpleEventRelayComponent.
+	// Falls back to a multicast if a relevant client has no relay so the event isn't lost.
+	void RelayRelevantEvent(
+		const USimpleEventRelevancyPolicy* RelevancyPolicy, bool IsReliable, FGuid EventID, FGameplayTag EventTag,
+		FGameplayTag DomainTag, const FInstancedStruct& Payload, UObject* Sender, ESimpleEventReplicationPolicy ReplicationPolicy);
+	bool IsUsingIrisReplication() const;
+	bool ShouldBatchReplicatedEvents() const;
+	TArray<FReplicatedEventBatchEntry>& GetPendingEventQueue(EReplicatedEventTarget Target, bool IsReliable);
+	bool IsUnreliableEventRateLimited(FGameplayTag EventTag);
+	void FlushReplicatedEvents();
+	void OnWorldPostActorTick(UWorld* World, ELevelTick TickType, float DeltaSeconds);
+
+	FAbilityCooldown* FindCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, FGameplayTag CooldownTag);
+	void SetCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, FGameplayTag CooldownTag, float Duration);
+	void ModifyCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, FGameplayTag CooldownTag, float TimeDelta);
+	void RemoveCooldown(TSubclassOf<USimpleGameplayAbility> AbilityClass, FGameplayTag CooldownTag, bool SendEndedEvent);
+	FFloatAttributeContainer& GetAuthorityFloatAttributeContainer(EAttributeReplicationScope ReplicationScope);
+
+	// Marks a float attribute dirty, or holds it back according to its ReplicationSettings
+	void MarkFloatAttributeDirty(FFloatAttribute& Attribute);
+	bool ShouldReplicateFloatAttribute(const FFloatAttribute& Attribute, double CurrentTime, double& OutReplicationTime) const;
+	void ReplicateFloatAttribute(FFloatAttribute& Attribute, double CurrentTime);
+	void ScheduleFloatAttributeFlush(double Delay);
+	void FlushPendingFloatAttributes();
+
+	// Float attributes that were held back and the time they should be replicated at
+	TMap<FGameplayTag, double> PendingFloatAttributeReplications;
+	// Handle and fire time (in USimpleTimerSubsystem time) of the pending flush
+	uint64 PendingFloatAttributeTimerHandle = 0;
+	double PendingFloatAttributeFlushTime = 0.0;
+	FStructAttributeContainer& GetAuthorityStructAttributeContainer(EAttributeReplicationScope ReplicationScope);
+	TArray<FFloatAttributeContainer*, TInlineAllocator<4>> GetAuthorityFloatAttributeContainers();
+	TArray<FStructAttributeContainer*, TInlineAllocator<4>> GetAuthorityStructAttributeContainers();
+	
+	void ScheduleCooldownExpiry(FAbilityCooldown& Cooldown);
+	void CancelCooldownExpiry(FAbilityCooldown& Cooldown);
+	void OnCooldownExpired(TSubclassOf<USimpleGameplayAbility> AbilityClass, FGameplayTag CooldownTag);
+
+	/* Replicated properties are push based, so every change to a replicated fast array has to go through these */
+	void MarkContainerDirty(FFastArraySerializer& Container);
+	void MarkContainerItemDirty(FFastArraySerializer& Container, FFastArraySerializerItem& Item);
+	void MarkContainerPropertyDirty(const FFastArraySerializer& Container);
+
+	// Wakes the owning actor up if it was made dormant by UseIdleNetDormancy and restarts the idle countdown
+	void NotifyReplicatedStateChanged();
+	void ScheduleDormancyCheck(double Delay);
+	void OnDormancyCheck();
+	void SetIdleDormant(bool Dormant);
+
+	double LastReplicatedStateChangeTime = 0.0;
+	uint64 DormancyCheckTimerHandle = 0;
+	bool IdleDormant = false;
+	bool IsTrackingIdleDormancy = false;
 
 private:
 	// Called on the client after an ability or attribute state has been added, changed or removed
 	void OnStateAdded(const FAbilityState& NewAbilityState);
 	void OnStateChanged(const FAbilityState& AuthorityAbilityState);
 	void OnStateRemoved(const FAbilityState& RemovedAbilityState);
-	void CompareSnapshots(const FAbilityState& AuthorityAbilityState, FAbilityState& LocalAbilityState);
-	
-	void OnFloatAttributeAdded(const FFloatAttribute& NewFloatAttribute);
-	void OnFloatAttributeChanged(const FFloatAttribute& ChangedFloatAttribute);
-	void OnFloatAttributeRemoved(const FFloatAttribute& RemovedFloatAttribute);
-
-	void OnStructAttributeAdded(const FStructAttribute& NewStructAttribute);
-	void OnStructAttributeChanged(const FStructAttribute& ChangedStructAttribute);
-	void OnStructAttributeRemoved(const FStructAttribute& RemovedStructAttribute);
-
-	void OnGameplayTagAdded(const FGameplayTagCounter& NewGameplayTag);
-	void OnGameplayTagChanged(const FGameplayTagCounter& ChangedGameplayTag);
-	void OnGameplayTagRemoved(const FGameplayTagCounter& RemovedGameplayTag);
+	void CompareSnapshots(const FAbilityStatePayload& AuthorityPayload, FAbilityStatePayload& LocalPayload);
+
+	// Called on the client after the payload of an ability or attribute state has been added or changed
+	void OnAbilityStatePayloadAdded(const FAbilityStatePayload& NewPayload);
+	void OnAbilityStatePayloadChanged(const FAbilityStatePayload& AuthorityPayload);
+	void OnAttributeStatePayloadAdded(const FAbilityStatePayload& NewPayload);
+	void OnAttributeStatePayloadChanged(const FAbilityStatePayload& AuthorityPayload);
+
+	void ClientActivateAbilityFromState(const FAbilityState& AuthorityAbilityState, bool ForceCancelRunningInstance);
+	void ClientFastForwardAttributeModifier(const FAbilityState& AuthorityAttributeState, const FAbilityStatePayload& AuthorityPayload);
+	void ClientResolveAttributeModifierSnapshots(const FAbilityStatePayload& AuthorityPayload);
+	FAbilityStatePayload* FindOrAddStatePayload(FAbilityStatePayloadContainer& AuthorityPayloads, TArray<FAbilityStatePayload>& LocalPayloads,
+		FGuid StateID, bool IsAuthorityState, bool CreateIfMissing);
+
+	// Replicated states whose payload hasn't arrived yet. They are handled once the payload replicates.
+	TSet<FGuid> PendingStatePayloads;
+
+	// GetServerTime result for the frame in CachedServerTimeFrame
+	double CachedServerTime = 0.0;
+	uint64 CachedServerTimeFrame = MAX_uint64;
+
+	// Returns the local network clock if UseNetworkClock is set and it has synced
+	USimpleNetworkClockComponent* GetNetworkClock();
+
+	TWeakObjectPtr<USimpleNetworkClockComponent> NetworkClock;
+	double NextNetworkClockLookupTime = 0.0;
+	
+	// Replication callbacks receive every index from one update and resolve predictions against the replicated items
+	void OnFloatAttributesAdded(FFloatAttributeContainer& Container, const TArrayView<int32>& AddedIndices);
+	void OnFloatAttributesChanged(FFloatAttributeContainer& Container, const TArrayView<int32>& ChangedIndices);
+	void OnFloatAttributesRemoved(const FFloatAttributeContainer& Container, const TArrayView<int32>& RemovedIndices);
+
+	void OnStructAttributesAdded(FStructAttributeContainer& Container, const TArrayView<int32>& AddedIndices);
+	void OnStructAttributesChanged(FStructAttributeContainer& Container, const TArrayView<int32>& ChangedIndices);
+	void OnStructAttributesRemoved(FStructAttributeContainer& Container, const TArrayView<int32>& RemovedIndices);
+	void SendStructAttributeChangedEvent(const FStructAttribute& Attribute, FInstancedStruct&& OldValue);
+	void StorePreviousStructAttributeValue(FStructAttribute& Attribute) const;
+
+	void OnGameplayTagsAdded(const FGameplayTagCounterContainer& Container, const TArrayView<int32>& AddedIndices);
+	void OnGameplayTagsChanged(const FGameplayTagCounterContainer& Container, const TArrayView<int32>& ChangedIndices);
+	void OnGameplayTagsRemoved(const FGameplayTagCounterContainer& Container, const TArrayView<int32>& RemovedIndices);
+
+	// Attributes replicated since the last PostRepNotifies, sent together in one AttributesChanged event
+	FGameplayTagContainer PendingChangedAttributeTags;
+
+	// Removed items are still in their container during the callback, so their events wait for PostRepNotifies
+	FGameplayTagContainer PendingRemovedFloatAttributeTags;
+	FGameplayTagContainer PendingRemovedStructAttributeTags;
+	FGameplayTagContainer PendingRemovedGameplayTags;
+
+	void OnAbilityCooldownAdded(const FAbilityCooldown& NewCooldown);
+	void OnAbilityCooldownChanged(const FAbilityCooldown& ChangedCooldown);
+	void OnAbilityCooldownRemoved(const FAbilityCooldown& RemovedCooldown);
 	
 	virtual void GetLifetimeReplicatedProps(TArray<class FLifetimeProperty>& OutLifetimeProps) const override;
 };
@@ -6,37 +6,68 @@
 #include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
 #include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAttributeModifier/SimpleAttributeModifier.h"
 #include "SimpleGameplayAbilitySystem/SimpleEventSubsystem/SimpleEventSubSystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleTimerSubsystem/SimpleTimerSubsystem.h"
 
 using enum EAbilityStatus;
 
 void USimpleGameplayAbilityComponent::AddFloatAttribute(FFloatAttribute AttributeToAdd, bool OverrideValuesIfExists)
 {
-	for (FFloatAttribute& AuthorityAttribute : AuthorityFloatAttributes.Attributes)
+	FFloatAttributeContainer& TargetContainer = GetAuthorityFloatAttributeContainer(AttributeToAdd.ReplicationScope);
+
+	// Adding always replicates the full attribute
+	AttributeToAdd.LastReplicatedBaseValue = AttributeToAdd.BaseValue;
+	AttributeToAdd.LastReplicatedCurrentValue = AttributeToAdd.CurrentValue;
+	AttributeToAdd.LastReplicatedValueLimits = AttributeToAdd.ValueLimits;
+	AttributeToAdd.LastReplicatedTime = GetWorld()->GetTimeSeconds();
+	
+	for (FFloatAttributeContainer* Container : GetAuthorityFloatAttributeContainers())
 	{
-		if (AuthorityAttribute.AttributeTag.MatchesTagExact(AttributeToAdd.AttributeTag))
+		const int32 AttributeIndex = Container->Attributes.IndexOfByPredicate([&AttributeToAdd](const FFloatAttribute& Attribute) { return Attribute.AttributeTag.MatchesTagExact(AttributeToAdd.AttributeTag); });
+
+		if (AttributeIndex == INDEX_NONE)
 		{
-			// Attribute exists but we don't want to override it
-			if (!OverrideValuesIfExists)
-			{
-				return;
-			}
+			continue;
+		}
+		
+		// Attribute exists but we don't want to override it
+		if (!OverrideValuesIfExists)
+		{
+			return;
+		}
 
-			// Attribute exists and we want to override it
-			AuthorityAttribute = AttributeToAdd;
-			AuthorityFloatAttributes.MarkItemDirty(AuthorityAttribute);
+		// Attribute exists and we want to override it
+		PendingFloatAttributeReplications.Remove(AttributeToAdd.AttributeTag);
+		
+		if (Container == &TargetContainer)
+		{
+			Container->Attributes[AttributeIndex] = AttributeToAdd;
+			MarkContainerItemDirty(*Container, Container->Attributes[AttributeIndex]);
 			return;
 		}
+
+		// The replication scope changed so the attribute moves to a different container
+		Container->Attributes.RemoveAt(AttributeIndex);
+		MarkContainerDirty(*Container);
+		TargetContainer.Attributes.Add(AttributeToAdd);
+		MarkContainerDirty(TargetContainer);
+		return;
 	}
 	
-	AuthorityFloatAttributes.Attributes.Add(AttributeToAdd);
-	AuthorityFloatAttributes.MarkArrayDirty();
+	TargetContainer.Attributes.Add(AttributeToAdd);
+	MarkContainerDirty(TargetContainer);
 	SendEvent(FDefaultTags::FloatAttributeAdded(), AttributeToAdd.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
 void USimpleGameplayAbilityComponent::RemoveFloatAttribute(FGameplayTag AttributeTag)
 {
-	AuthorityFloatAttributes.Attributes.RemoveAll([AttributeTag](const FFloatAttribute& Attribute) { return Attribute.AttributeTag == AttributeTag; });
-	AuthorityFloatAttributes.MarkArrayDirty();
+	for (FFloatAttributeContainer* Container : GetAuthorityFloatAttributeContainers())
+	{
+		if (Container->Attributes.RemoveAll([AttributeTag](const FFloatAttribute& Attribute) { return Attribute.AttributeTag == AttributeTag; }) > 0)
+		{
+			MarkContainerDirty(*Container);
+		}
+	}
+	
 	SendEvent(FDefaultTags::FloatAttributeRemoved(), AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
@@ -48,10 +79,23 @@ void USimpleGameplayAbilityComponent::AddStructAttribute(FStructAttribute Attrib
 		return;
 	}
 	
-	const int32 AttributeIndex = AuthorityStructAttributes.Attributes.Find(AttributeToAdd);
+	FStructAttributeContainer& TargetContainer = GetAuthorityStructAttributeContainer(AttributeToAdd.ReplicationScope);
+	FStructAttributeContainer* ExistingContainer = nullptr;
+	int32 AttributeIndex = INDEX_NONE;
+
+	for (FStructAttributeContainer* Container : GetAuthorityStructAttributeContainers())
+	{
+		AttributeIndex = Container->Attributes.Find(AttributeToAdd);
+
+		if (AttributeIndex != INDEX_NONE)
+		{
+			ExistingContainer = Container;
+			break;
+		}
+	}
 	
 	// This is a new attribute
-	if (AttributeIndex == INDEX_NONE)
+	if (!ExistingContainer)
 	{
 		// Initialise the data within the struct
 		if (AttributeToAdd.StructType)
@@ -59,8 +103,8 @@ void USimpleGameplayAbilityComponent::AddStructAttribute(FStructAttribute Attrib
 			AttributeToAdd.AttributeValue.InitializeAs(AttributeToAdd.StructType);
 		}
 		
-		AuthorityStructAttributes.Attributes.AddUnique(AttributeToAdd);
-		AuthorityStructAttributes.MarkArrayDirty();
+		TargetContainer.Attributes.AddUnique(AttributeToAdd);
+		MarkContainerDirty(TargetContainer);
 
 		SendEvent(FDefaultTags::StructAttributeAdded(), AttributeToAdd.AttributeTag, AttributeToAdd.AttributeValue, GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 		
@@ -74,14 +118,30 @@ void USimpleGameplayAbilityComponent::AddStructAttribute(FStructAttribute Attrib
 	}
 
 	// Attribute exists and we want to override it
-	AuthorityStructAttributes.Attributes[AttributeIndex] = AttributeToAdd;
-	AuthorityStructAttributes.MarkItemDirty(AuthorityStructAttributes.Attributes[AttributeIndex]);
+	if (ExistingContainer == &TargetContainer)
+	{
+		TargetContainer.Attributes[AttributeIndex] = AttributeToAdd;
+		MarkContainerItemDirty(TargetContainer, TargetContainer.Attributes[AttributeIndex]);
+		return;
+	}
+
+	// The replication scope changed so the attribute moves to a different container
+	ExistingContainer->Attributes.RemoveAt(AttributeIndex);
+	MarkContainerDirty(*ExistingContainer);
+	TargetContainer.Attributes.Add(AttributeToAdd);
+	MarkContainerDirty(TargetContainer);
 }
 
 void USimpleGameplayAbilityComponent::RemoveStructAttribute(FGameplayTag AttributeTag)
 {
-	AuthorityStructAttributes.Attributes.RemoveAll([AttributeTag](const FStructAttribute& Attribute) { return Attribute.AttributeTag == AttributeTag; });
-	AuthorityStructAttributes.MarkArrayDirty();
+	for (FStructAttributeContainer* Container : GetAuthorityStructAttributeContainers())
+	{
+		if (Container->Attributes.RemoveAll([AttributeTag](const FStructAttribute& Attribute) { return Attribute.AttributeTag == AttributeTag; }) > 0)
+		{
+			MarkContainerDirty(*Container);
+		}
+	}
+	
 	SendEvent(FDefaultTags::StructAttributeRemoved(), AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 }
 
@@ -97,39 +157,39 @@ bool USimpleGameplayAbilityComponent::ApplyAttributeModifierToTarget(
 		return false;
 	}
 	
-	ModifierID = FGuid::NewGuid();
-	USimpleAttributeModifier* Modifier = nullptr;
+	ModifierID = MakeNetID();
 
-	for (USimpleAttributeModifier* InstancedModifier : InstancedAttributes)
-	{
-		if (InstancedModifier->GetClass() == ModifierClass)
-		{
-			if (InstancedModifier->ModifierType == EAttributeModifierType::Duration && InstancedModifier->IsModifierActive())
-			{
-				if (InstancedModifier->CanStack)
-				{
-					InstancedModifier->AddModifierStack(1);
-					return true;
-				}
+	// A running duration modifier of the same class on the same target is stacked or replaced, other targets get their own instance
+	USimpleAttributeModifier* RunningModifier = ModifierTarget ? ModifierTarget->FindActiveModifierOfClass(ModifierClass, this) : nullptr;
 
-				InstancedModifier->EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
-			}
-
-			Modifier = InstancedModifier;
-			break;
-		}
+	if (RunningModifier && RunningModifier->CanStack)
+	{
+		// Stacks live on the running instance, so the returned ID is the one that can cancel them
+		ModifierID = RunningModifier->AbilityInstanceID;
+		RunningModifier->AddModifierStack(1);
+		return true;
 	}
 
-	if (!Modifier)
+	// Acquired before the running modifier ends so the replacement isn't the instance that was just released to the pool
+	USimpleAttributeModifier* Modifier = AcquireAttributeModifier(ModifierClass);
+
+	if (RunningModifier)
 	{
-		Modifier = NewObject<USimpleAttributeModifier>(this, ModifierClass);
-		InstancedAttributes.Add(Modifier);
+		RunningModifier->EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
 	}
 	
 	Modifier->InitializeAbility(this, ModifierID, false);
 	CreateAttributeState(ModifierClass, ModifierContext, ModifierID);
 	
-	return Modifier->ApplyModifier(this, ModifierTarget, ModifierContext);
+	const bool WasApplied = Modifier->ApplyModifier(this, ModifierTarget, ModifierContext);
+
+	// Instant modifiers and modifiers that failed to apply are done already
+	if (!Modifier->IsModifierActive())
+	{
+		ReleaseAttributeModifier(Modifier);
+	}
+
+	return WasApplied;
 }
 
 bool USimpleGameplayAbilityComponent::ApplyAttributeModifierToSelf(
@@ -142,31 +202,19 @@ bool USimpleGameplayAbilityComponent::ApplyAttributeModifierToSelf(
 
 void USimpleGameplayAbilityComponent::AddAttributeStateSnapshot(FGuid AbilityInstanceID, FSimpleAbilitySnapshot State)
 {
-	if (HasAuthority())
+	if (!GetAttributeState(AbilityInstanceID, HasAuthority()))
 	{
-		for (FAbilityState& AuthorityAttributeState : AuthorityAttributeStates.AbilityStates)
-		{
-			if (AuthorityAttributeState.AbilityID == AbilityInstanceID)
-			{
-				AuthorityAttributeState.SnapshotHistory.Add(State);
-				AuthorityAttributeStates.MarkItemDirty(AuthorityAttributeState);
-				return;
-			}
-		}
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::AddAttributeStateSnapshot]: Attribute with ID %s not found in InstancedAttributes array"), *AbilityInstanceID.ToString()));
+		return;
 	}
-	else
+
+	FAbilityStatePayload* StatePayload = GetAttributeStatePayload(AbilityInstanceID, HasAuthority(), true);
+	StatePayload->SnapshotHistory.Add(State);
+
+	if (HasAuthority())
 	{
-		for (FAbilityState& ActiveAttribute : LocalAttributeStates)
-		{
-			if (ActiveAttribute.AbilityID == AbilityInstanceID)
-			{
-				ActiveAttribute.SnapshotHistory.Add(State);
-				return;
-			}
-		}
+		MarkContainerItemDirty(AuthorityAttributeStatePayloads, *StatePayload);
 	}
-
-	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleGameplayAbilityComponent::AddAttributeStateSnapshot]: Attribute with ID %s not found in InstancedAttributes array"), *AbilityInstanceID.ToString()));
 }
 
 void USimpleGameplayAbilityComponent::CancelAttributeModifier(FGuid ModifierID)
@@ -205,7 +253,9 @@ void USimpleGameplayAbilityComponent::CancelAttributeModifier(FGuid ModifierID)
 			{
 				for (const FAttributeModifierSideEffect& AttributeModifier : ModifierResult->AppliedAttributeModifierSideEffects)
 				{
-					if (USimpleAttributeModifier* AttributeModifierInstance = GetAttributeModifierInstance(AttributeModifier.AttributeID))
+					USimpleAttributeModifier* AttributeModifierInstance = GetAttributeModifierInstance(AttributeModifier.AttributeID);
+
+					if (AttributeModifierInstance && AttributeModifierInstance->IsModifierActive())
 					{
 						AttributeModifierInstance->EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
 					}
@@ -217,8 +267,11 @@ void USimpleGameplayAbilityComponent::CancelAttributeModifier(FGuid ModifierID)
 
 void USimpleGameplayAbilityComponent::CancelAttributeModifiersWithTags(FGameplayTagContainer Tags)
 {
-	// We go through all active modifiers and cancel them if any of their tags match the provided tags
-	for (USimpleAttributeModifier* ModifierInstance : InstancedAttributes)
+	// We go through all active modifiers and cancel them if any of their tags match the provided tags.
+	// Cancelled modifiers release themselves from InstancedAttributes so we iterate over a copy.
+	const TArray<USimpleAttributeModifier*> ModifierInstances = InstancedAttributes;
+
+	for (USimpleAttributeModifier* ModifierInstance : ModifierInstances)
 	{
 		if (ModifierInstance->IsModifierActive() && ModifierInstance->ModifierTags.HasAnyExact(Tags))
 		{
@@ -227,6 +280,107 @@ void USimpleGameplayAbilityComponent::CancelAttributeModifiersWithTags(FGameplay
 	}
 }
 
+void USimpleGameplayAbilityComponent::CancelActiveModifiersOnSelfWithTags(FGameplayTagContainer Tags)
+{
+	// Cancelled modifiers unregister themselves, so we collect the matches first. A modifier can match more than one tag.
+	TArray<USimpleAttributeModifier*> ModifiersToCancel;
+
+	for (const FGameplayTag& Tag : Tags)
+	{
+		if (const FAttributeModifierList* TaggedModifiers = ActiveModifiersByTag.Find(Tag))
+		{
+			for (USimpleAttributeModifier* Modifier : TaggedModifiers->Modifiers)
+			{
+				ModifiersToCancel.AddUnique(Modifier);
+			}
+		}
+	}
+
+	// Same as the instigator's CancelAttributeModifier would do for an active duration modifier
+	for (USimpleAttributeModifier* Modifier : ModifiersToCancel)
+	{
+		if (Modifier->IsModifierActive())
+		{
+			Modifier->EndModifier(FDefaultTags::AbilityCancelled(), FInstancedStruct());
+		}
+	}
+}
+
+bool USimpleGameplayAbilityComponent::HasActiveModifierWithTags(const FGameplayTagContainer& Tags) const
+{
+	for (const FGameplayTag& Tag : Tags)
+	{
+		const FAttributeModifierList* TaggedModifiers = ActiveModifiersByTag.Find(Tag);
+
+		if (TaggedModifiers && TaggedModifiers->Modifiers.Num() > 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+USimpleAttributeModifier* USimpleGameplayAbilityComponent::FindActiveModifierOfClass(const UClass* ModifierClass, const USimpleGameplayAbilityComponent* Instigator) const
+{
+	const FAttributeModifierList* ClassModifiers = ActiveModifiersByClass.Find(ModifierClass);
+
+	if (!ClassModifiers)
+	{
+		return nullptr;
+	}
+
+	for (USimpleAttributeModifier* Modifier : ClassModifiers->Modifiers)
+	{
+		if (Modifier->OwningAbilityComponent == Instigator)
+		{
+			return Modifier;
+		}
+	}
+
+	return nullptr;
+}
+
+void USimpleGameplayAbilityComponent::RegisterActiveModifier(USimpleAttributeModifier* Modifier)
+{
+	if (!Modifier)
+	{
+		return;
+	}
+
+	FAttributeModifierList& ClassModifiers = ActiveModifiersByClass.FindOrAdd(Modifier->GetClass());
+
+	if (ClassModifiers.Modifiers.Contains(Modifier))
+	{
+		return;
+	}
+
+	ClassModifiers.Modifiers.Add(Modifier);
+
+	for (const FGameplayTag& Tag : Modifier->ModifierTags)
+	{
+		ActiveModifiersByTag.FindOrAdd(Tag).Modifiers.Add(Modifier);
+	}
+}
+
+void USimpleGameplayAbilityComponent::UnregisterActiveModifier(USimpleAttributeModifier* Modifier)
+{
+	FAttributeModifierList* ClassModifiers = Modifier ? ActiveModifiersByClass.Find(Modifier->GetClass()) : nullptr;
+
+	if (!ClassModifiers || ClassModifiers->Modifiers.RemoveSingleSwap(Modifier) == 0)
+	{
+		return;
+	}
+
+	for (const FGameplayTag& Tag : Modifier->ModifierTags)
+	{
+		if (FAttributeModifierList* TaggedModifiers = ActiveModifiersByTag.Find(Tag))
+		{
+			TaggedModifiers->Modifiers.RemoveSingleSwap(Modifier);
+		}
+	}
+}
+
 void USimpleGameplayAbilityComponent::CreateAttributeState(
 	const TSubclassOf<USimpleAttributeModifier>& AttributeClass,
 	const FInstancedStruct& AttributeContext,
@@ -236,9 +390,9 @@ void USimpleGameplayAbilityComponent::CreateAttributeState(
 	
 	NewAttributeState.AbilityID = AttributeInstanceID;
 	NewAttributeState.AbilityClass = AttributeClass;
-	NewAttributeState.ActivationTimeStamp = GetServerTime();
-	NewAttributeState.ActivationContext = AttributeContext;
+	NewAttributeState.ActivationTimeStamp = GetCachedServerTime();
 	NewAttributeState.AbilityStatus = ActivationSuccess;
+	NewAttributeState.HasActivationContext = AttributeContext.IsValid();
 	
 	if (HasAuthority())
 	{
@@ -255,7 +409,7 @@ void USimpleGameplayAbilityComponent::CreateAttributeState(
 		NewAttributeStateItem = NewAttributeState;
 
 		AuthorityAttributeStates.AbilityStates.Add(NewAttributeStateItem);
-		AuthorityAttributeStates.MarkArrayDirty();
+		MarkContainerDirty(AuthorityAttributeStates);
 	}
 	else
 	{
@@ -270,6 +424,12 @@ void USimpleGameplayAbilityComponent::CreateAttributeState(
 		
 		LocalAttributeStates.Add(NewAttributeState);
 	}
+
+	if (NewAttributeState.HasActivationContext)
+	{
+		FAbilityStatePayload* StatePayload = GetAttributeStatePayload(AttributeInstanceID, HasAuthority(), true);
+		StatePayload->ActivationContext = AttributeContext;
+	}
 }
 
 bool USimpleGameplayAbilityComponent::HasFloatAttribute(const FGameplayTag AttributeTag)
@@ -324,7 +484,7 @@ float USimpleGameplayAbilityComponent::GetFloatAttributeValue(EAttributeValueTyp
 
 bool USimpleGameplayAbilityComponent::SetFloatAttributeValue(EAttributeValueType ValueType, FGameplayTag AttributeTag, float NewValue, float& Overflow)
 {
-	FFloatAttribute* Attribute = GetFloatAttribute(AttributeTag);
+	FFloatAttribute* Attribute = GetMutableFloatAttribute(AttributeTag);
 	
 	if (!Attribute)
 	{
@@ -364,7 +524,7 @@ bool USimpleGameplayAbilityComponent::SetFloatAttributeValue(EAttributeValueType
 
 	if (HasAuthority())
 	{
-		AuthorityFloatAttributes.MarkItemDirty(*Attribute);
+		MarkFloatAttributeDirty(*Attribute);
 	}
 	
 	return true;
@@ -385,22 +545,23 @@ bool USimpleGameplayAbilityComponent::IncrementFloatAttributeValue(EAttributeVal
 
 bool USimpleGameplayAbilityComponent::OverrideFloatAttribute(FGameplayTag AttributeTag, FFloatAttribute NewAttribute)
 {
-	for (FFloatAttribute& Attribute : AuthorityFloatAttributes.Attributes)
+	// The replication scope is kept as is, since changing it would mean moving the attribute to another container
+	if (FFloatAttribute* Attribute = GetMutableFloatAttribute(AttributeTag))
 	{
-		if (Attribute.AttributeTag.MatchesTagExact(AttributeTag))
+		CompareFloatAttributesAndSendEvents(*Attribute, NewAttribute);
+		
+		Attribute->AttributeName = NewAttribute.AttributeName;
+		Attribute->AttributeTag = NewAttribute.AttributeTag;
+		Attribute->BaseValue = NewAttribute.BaseValue;
+		Attribute->CurrentValue = NewAttribute.CurrentValue;
+		Attribute->ValueLimits = NewAttribute.ValueLimits;
+
+		if (HasAuthority())
 		{
-			CompareFloatAttributesAndSendEvents(Attribute, NewAttribute);
-			
-			Attribute.AttributeName = NewAttribute.AttributeName;
-			Attribute.AttributeTag = NewAttribute.AttributeTag;
-			Attribute.BaseValue = NewAttribute.BaseValue;
-			Attribute.CurrentValue = NewAttribute.CurrentValue;
-			Attribute.ValueLimits = NewAttribute.ValueLimits;
-			
-			AuthorityFloatAttributes.MarkItemDirty(Attribute);
-			
-			return true;
+			MarkFloatAttributeDirty(*Attribute);
 		}
+		
+		return true;
 	}
 
 	SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleAttributeFunctionLibrary::OverrideFloatAttribute]: Attribute %s not found."), *AttributeTag.ToString()));
@@ -426,7 +587,7 @@ USimpleAttributeHandler* USimpleGameplayAbilityComponent::GetStructAttributeHand
 
 FInstancedStruct USimpleGameplayAbilityComponent::GetStructAttributeValue(FGameplayTag AttributeTag, bool& WasFound)
 {
-	if (FStructAttribute* Attribute = GetStructAttribute(AttributeTag))
+	if (const FStructAttribute* Attribute = GetStructAttribute(AttributeTag))
 	{
 		WasFound = true;
 		return Attribute->AttributeValue;
@@ -439,7 +600,7 @@ FInstancedStruct USimpleGameplayAbilityComponent::GetStructAttributeValue(FGamep
 
 bool USimpleGameplayAbilityComponent::SetStructAttributeValue(const FGameplayTag AttributeTag, const FInstancedStruct NewValue)
 {
-	FStructAttribute* Attribute = GetStructAttribute(AttributeTag);
+	FStructAttribute* Attribute = GetMutableStructAttribute(AttributeTag);
 	
 	if (!Attribute)
 	{
@@ -462,7 +623,7 @@ bool USimpleGameplayAbilityComponent::SetStructAttributeValue(const FGameplayTag
 	
 	if (HasAuthority())
 	{
-		AuthorityStructAttributes.MarkItemDirty(*Attribute);
+		MarkContainerItemDirty(GetAuthorityStructAttributeContainer(Attribute->ReplicationScope), *Attribute);
 	}
 	
 	SendEvent(FDefaultTags::StructAttributeValueChanged(), AttributeTag, FInstancedStruct::Make(Payload), this, { }, ESimpleEventReplicationPolicy::NoReplication);
@@ -574,25 +735,80 @@ void USimpleGameplayAbilityComponent::ApplyAbilitySideEffects(USimpleGameplayAbi
 {
 	for (const FAbilitySideEffect& SideEffect : AbilitySideEffects)
 	{
-		Instigator->ActivateAbilityWithID(FGuid::NewGuid(), SideEffect.AbilityClass, SideEffect.AbilityContext, true, SideEffect.ActivationPolicy);
+		Instigator->ActivateAbilityWithID(Instigator->MakeNetID(), SideEffect.AbilityClass, SideEffect.AbilityContext, true, SideEffect.ActivationPolicy);
+	}
+}
+
+const FFloatAttribute* USimpleGameplayAbilityComponent::GetFloatAttribute(const FGameplayTag AttributeTag)
+{
+	// Only clients predict, so on the server this goes straight to the authority containers
+	for (const FFloatAttribute& PredictedAttribute : PredictedFloatAttributes)
+	{
+		if (PredictedAttribute.AttributeTag.MatchesTagExact(AttributeTag))
+		{
+			return &PredictedAttribute;
+		}
+	}
+
+	return FindAuthorityFloatAttribute(AttributeTag);
+}
+
+const FStructAttribute* USimpleGameplayAbilityComponent::GetStructAttribute(const FGameplayTag AttributeTag)
+{
+	for (const FStructAttribute& PredictedAttribute : PredictedStructAttributes)
+	{
+		if (PredictedAttribute.AttributeTag.MatchesTagExact(AttributeTag))
+		{
+			return &PredictedAttribute;
+		}
 	}
+
+	return FindAuthorityStructAttribute(AttributeTag);
 }
 
-FFloatAttribute* USimpleGameplayAbilityComponent::GetFloatAttribute(FGameplayTag AttributeTag)
+FFloatAttribute* USimpleGameplayAbilityComponent::GetMutableFloatAttribute(const FGameplayTag AttributeTag)
 {
 	if (HasAuthority())
 	{
-		for (FFloatAttribute& FloatAttribute : AuthorityFloatAttributes.Attributes)
+		return FindAuthorityFloatAttribute(AttributeTag);
+	}
+
+	for (FFloatAttribute& PredictedAttribute : PredictedFloatAttributes)
+	{
+		if (PredictedAttribute.AttributeTag.MatchesTagExact(AttributeTag))
 		{
-			if (FloatAttribute.AttributeTag.MatchesTagExact(AttributeTag))
-			{
-				return &FloatAttribute;
-			}
+			return &PredictedAttribute;
 		}
 	}
-	else
+
+	const FFloatAttribute* ReplicatedAttribute = FindAuthorityFloatAttribute(AttributeTag);
+	return ReplicatedAttribute ? &PredictedFloatAttributes.Add_GetRef(*ReplicatedAttribute) : nullptr;
+}
+
+FStructAttribute* USimpleGameplayAbilityComponent::GetMutableStructAttribute(const FGameplayTag AttributeTag)
+{
+	if (HasAuthority())
 	{
-		for (FFloatAttribute& FloatAttribute : LocalFloatAttributes)
+		return FindAuthorityStructAttribute(AttributeTag);
+	}
+
+	for (FStructAttribute& PredictedAttribute : PredictedStructAttributes)
+	{
+		if (PredictedAttribute.AttributeTag.MatchesTagExact(AttributeTag))
+		{
+			return &PredictedAttribute;
+		}
+	}
+
+	const FStructAttribute* ReplicatedAttribute = FindAuthorityStructAttribute(AttributeTag);
+	return ReplicatedAttribute ? &PredictedStructAttributes.Add_GetRef(*ReplicatedAttribute) : nullptr;
+}
+
+FFloatAttribute* USimpleGameplayAbilityComponent::FindAuthorityFloatAttribute(const FGameplayTag AttributeTag)
+{
+	for (FFloatAttributeContainer* Container : GetAuthorityFloatAttributeContainers())
+	{
+		for (FFloatAttribute& FloatAttribute : Container->Attributes)
 		{
 			if (FloatAttribute.AttributeTag.MatchesTagExact(AttributeTag))
 			{
@@ -604,11 +820,11 @@ FFloatAttribute* USimpleGameplayAbilityComponent::GetFloatAttribute(FGameplayTag
 	return nullptr;
 }
 
-FStructAttribute* USimpleGameplayAbilityComponent::GetStructAttribute(FGameplayTag AttributeTag)
+FStructAttribute* USimpleGameplayAbilityComponent::FindAuthorityStructAttribute(const FGameplayTag AttributeTag)
 {
-	if (HasAuthority())
+	for (FStructAttributeContainer* Container : GetAuthorityStructAttributeContainers())
 	{
-		for (FStructAttribute& StructAttribute : AuthorityStructAttributes.Attributes)
+		for (FStructAttribute& StructAttribute : Container->Attributes)
 		{
 			if (StructAttribute.AttributeTag.MatchesTagExact(AttributeTag))
 			{
@@ -616,87 +832,416 @@ FStructAttribute* USimpleGameplayAbilityComponent::GetStructAttribute(FGameplayT
 			}
 		}
 	}
-	else
+
+	return nullptr;
+}
+
+void USimpleGameplayAbilityComponent::CopyAuthorityAttributes(TArray<FFloatAttribute>& OutFloatAttributes, TArray<FStructAttribute>& OutStructAttributes) const
+{
+	OutFloatAttributes = AuthorityFloatAttributes.Attributes;
+	OutFloatAttributes.Append(AuthorityOwnerOnlyFloatAttributes.Attributes);
+	OutFloatAttributes.Append(AuthoritySimulatedOnlyFloatAttributes.Attributes);
+	OutFloatAttributes.Append(AuthorityUnreplicatedFloatAttributes.Attributes);
+
+	OutStructAttributes = AuthorityStructAttributes.Attributes;
+	OutStructAttributes.Append(AuthorityOwnerOnlyStructAttributes.Attributes);
+	OutStructAttributes.Append(AuthoritySimulatedOnlyStructAttributes.Attributes);
+	OutStructAttributes.Append(AuthorityUnreplicatedStructAttributes.Attributes);
+}
+
+FFloatAttributeContainer& USimpleGameplayAbilityComponent::GetAuthorityFloatAttributeContainer(const EAttributeReplicationScope ReplicationScope)
+{
+	switch (ReplicationScope)
+	{
+		case EAttributeReplicationScope::OwnerOnly:
+			return AuthorityOwnerOnlyFloatAttributes;
+		case EAttributeReplicationScope::SimulatedOnly:
+			return AuthoritySimulatedOnlyFloatAttributes;
+		case EAttributeReplicationScope::None:
+			return AuthorityUnreplicatedFloatAttributes;
+		default:
+			return AuthorityFloatAttributes;
+	}
+}
+
+void USimpleGameplayAbilityComponent::MarkFloatAttributeDirty(FFloatAttribute& Attribute)
+{
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	double ReplicationTime = CurrentTime;
+
+	if (ShouldReplicateFloatAttribute(Attribute, CurrentTime, ReplicationTime))
+	{
+		ReplicateFloatAttribute(Attribute, CurrentTime);
+		return;
+	}
+
+	double& PendingReplicationTime = PendingFloatAttributeReplications.FindOrAdd(Attribute.AttributeTag, ReplicationTime);
+	PendingReplicationTime = FMath::Min(PendingReplicationTime, ReplicationTime);
+
+	ScheduleFloatAttributeFlush(PendingReplicationTime - CurrentTime);
+}
+
+void USimpleGameplayAbilityComponent::ScheduleFloatAttributeFlush(const double Delay)
+{
+	USimpleTimerSubsystem* TimerSubsystem = GetWorld() ? GetWorld()->GetSubsystem<USimpleTimerSubsystem>() : nullptr;
+
+	if (!TimerSubsystem)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleGameplayAbilityComponent::ScheduleFloatAttributeFlush]: SimpleTimerSubsystem not found. Held back float attributes will not be replicated."));
+		return;
+	}
+
+	const double FlushTime = TimerSubsystem->GetTimerTime() + FMath::Max(Delay, 0.0);
+
+	// Only ever move the pending flush earlier, a flush that's already due sooner also covers this attribute
+	if (PendingFloatAttributeTimerHandle != 0)
 	{
-		for (FStructAttribute& StructAttribute : LocalStructAttributes)
+		if (PendingFloatAttributeFlushTime <= FlushTime)
 		{
-			if (StructAttribute.AttributeTag.MatchesTagExact(AttributeTag))
-			{
-				return &StructAttribute;
-			}
+			return;
 		}
+
+		TimerSubsystem->CancelTimer(PendingFloatAttributeTimerHandle);
 	}
 
-	return nullptr;
+	const FSimpleTimerDelegate FlushDelegate = FSimpleTimerDelegate::CreateWeakLambda(this, [this]()
+	{
+		PendingFloatAttributeTimerHandle = 0;
+		FlushPendingFloatAttributes();
+	});
+
+	PendingFloatAttributeFlushTime = FlushTime;
+	PendingFloatAttributeTimerHandle = TimerSubsystem->ScheduleTimer(FlushTime, FlushDelegate);
+}
+
+bool USimpleGameplayAbilityComponent::ShouldReplicateFloatAttribute(const FFloatAttribute& Attribute, const double CurrentTime, double& OutReplicationTime) const
+{
+	const FAttributeReplicationSettings& Settings = Attribute.ReplicationSettings;
+
+	if (!Settings.IsThrottled())
+	{
+		return true;
+	}
+
+	if (Settings.AlwaysReplicateImportantChanges)
+	{
+		const FValueLimits& Limits = Attribute.ValueLimits;
+		
+		const bool CrossedZero =
+			FMath::Sign(Attribute.CurrentValue) != FMath::Sign(Attribute.LastReplicatedCurrentValue) ||
+			FMath::Sign(Attribute.BaseValue) != FMath::Sign(Attribute.LastReplicatedBaseValue);
+
+		const bool ReachedLimit =
+			(Limits.UseMaxCurrentValue && Attribute.CurrentValue >= Limits.MaxCurrentValue && Attribute.LastReplicatedCurrentValue < Limits.MaxCurrentValue) ||
+			(Limits.UseMinCurrentValue && Attribute.CurrentValue <= Limits.MinCurrentValue && Attribute.LastReplicatedCurrentValue > Limits.MinCurrentValue) ||
+			(Limits.UseMaxBaseValue && Attribute.BaseValue >= Limits.MaxBaseValue && Attribute.LastReplicatedBaseValue < Limits.MaxBaseValue) ||
+			(Limits.UseMinBaseValue && Attribute.BaseValue <= Limits.MinBaseValue && Attribute.LastReplicatedBaseValue > Limits.MinBaseValue);
+
+		if (CrossedZero || ReachedLimit)
+		{
+			return true;
+		}
+	}
+
+	const double NextAllowedTime = Attribute.LastReplicatedTime + Settings.MinReplicationInterval;
+	const double LatestTime = Attribute.LastReplicatedTime + FMath::Max(Settings.MinReplicationInterval, Settings.MaxReplicationDelay);
+
+	if (CurrentTime >= LatestTime)
+	{
+		return true;
+	}
+
+	// A change is significant once it reaches either of the enabled thresholds
+	auto IsSignificantChange = [&Settings](const float LastValue, const float NewValue)
+	{
+		const float Change = FMath::Abs(NewValue - LastValue);
+
+		if (Change <= 0.0f)
+		{
+			return false;
+		}
+
+		const bool UseAbsoluteChange = Settings.MinAbsoluteChange > 0.0f;
+		const bool UseRelativeChange = Settings.MinRelativeChange > 0.0f;
+
+		if (!UseAbsoluteChange && !UseRelativeChange)
+		{
+			return true;
+		}
+
+		return (UseAbsoluteChange && Change >= Settings.MinAbsoluteChange) ||
+			(UseRelativeChange && Change >= Settings.MinRelativeChange * FMath::Abs(LastValue));
+	};
+
+	// Clients clamp with the value limits so a change to them can't wait
+	const bool HasSignificantChange =
+		Attribute.ValueLimits != Attribute.LastReplicatedValueLimits ||
+		IsSignificantChange(Attribute.LastReplicatedCurrentValue, Attribute.CurrentValue) ||
+		IsSignificantChange(Attribute.LastReplicatedBaseValue, Attribute.BaseValue);
+
+	if (HasSignificantChange && CurrentTime >= NextAllowedTime)
+	{
+		return true;
+	}
+
+	OutReplicationTime = HasSignificantChange ? NextAllowedTime : LatestTime;
+	return false;
 }
 
-void USimpleGameplayAbilityComponent::OnFloatAttributeAdded(const FFloatAttribute& NewFloatAttribute)
+void USimpleGameplayAbilityComponent::ReplicateFloatAttribute(FFloatAttribute& Attribute, const double CurrentTime)
 {
-	LocalFloatAttributes.AddUnique(NewFloatAttribute);
-	SendEvent(FDefaultTags::FloatAttributeAdded(), NewFloatAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+	Attribute.LastReplicatedBaseValue = Attribute.BaseValue;
+	Attribute.LastReplicatedCurrentValue = Attribute.CurrentValue;
+	Attribute.LastReplicatedValueLimits = Attribute.ValueLimits;
+	Attribute.LastReplicatedTime = CurrentTime;
+	PendingFloatAttributeReplications.Remove(Attribute.AttributeTag);
+	
+	MarkContainerItemDirty(GetAuthorityFloatAttributeContainer(Attribute.ReplicationScope), Attribute);
 }
 
-void USimpleGameplayAbilityComponent::OnFloatAttributeChanged(const FFloatAttribute& ChangedFloatAttribute)
+void USimpleGameplayAbilityComponent::FlushPendingFloatAttributes()
 {
-	for (FFloatAttribute& LocalFloatAttribute : LocalFloatAttributes)
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	double NextReplicationTime = TNumericLimits<double>::Max();
+	TArray<FGameplayTag> DueAttributes;
+
+	for (const TPair<FGameplayTag, double>& PendingAttribute : PendingFloatAttributeReplications)
 	{
-		if (LocalFloatAttribute.AttributeTag.MatchesTagExact(ChangedFloatAttribute.AttributeTag))
+		if (PendingAttribute.Value <= CurrentTime + UE_KINDA_SMALL_NUMBER)
 		{
-			CompareFloatAttributesAndSendEvents(LocalFloatAttribute, ChangedFloatAttribute);
-			LocalFloatAttribute = ChangedFloatAttribute;
-			return;
+			DueAttributes.Add(PendingAttribute.Key);
+		}
+		else
+		{
+			NextReplicationTime = FMath::Min(NextReplicationTime, PendingAttribute.Value);
 		}
 	}
 
-	LocalFloatAttributes.AddUnique(ChangedFloatAttribute);
-	SendEvent(FDefaultTags::FloatAttributeAdded(), ChangedFloatAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+	for (const FGameplayTag& AttributeTag : DueAttributes)
+	{
+		if (FFloatAttribute* Attribute = FindAuthorityFloatAttribute(AttributeTag))
+		{
+			ReplicateFloatAttribute(*Attribute, CurrentTime);
+		}
+		else
+		{
+			PendingFloatAttributeReplications.Remove(AttributeTag);
+		}
+	}
+
+	if (PendingFloatAttributeReplications.Num() > 0)
+	{
+		ScheduleFloatAttributeFlush(NextReplicationTime - CurrentTime);
+	}
+}
+
+FStructAttributeContainer& USimpleGameplayAbilityComponent::GetAuthorityStructAttributeContainer(const EAttributeReplicationScope ReplicationScope)
+{
+	switch (ReplicationScope)
+	{
+		case EAttributeReplicationScope::OwnerOnly:
+			return AuthorityOwnerOnlyStructAttributes;
+		case EAttributeReplicationScope::SimulatedOnly:
+			return AuthoritySimulatedOnlyStructAttributes;
+		case EAttributeReplicationScope::None:
+			return AuthorityUnreplicatedStructAttributes;
+		default:
+			return AuthorityStructAttributes;
+	}
 }
 
-void USimpleGameplayAbilityComponent::OnFloatAttributeRemoved(const FFloatAttribute& RemovedFloatAttribute)
+TArray<FFloatAttributeContainer*, TInlineAllocator<4>> USimpleGameplayAbilityComponent::GetAuthorityFloatAttributeContainers()
 {
-	LocalFloatAttributes.Remove(RemovedFloatAttribute);
-	SendEvent(FDefaultTags::FloatAttributeRemoved(), RemovedFloatAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+	return { &AuthorityFloatAttributes, &AuthorityOwnerOnlyFloatAttributes, &AuthoritySimulatedOnlyFloatAttributes, &AuthorityUnreplicatedFloatAttributes };
 }
 
-void USimpleGameplayAbilityComponent::OnStructAttributeAdded(const FStructAttribute& NewStructAttribute)
+TArray<FStructAttributeContainer*, TInlineAllocator<4>> USimpleGameplayAbilityComponent::GetAuthorityStructAttributeContainers()
 {
-	if (!LocalStructAttributes.Contains(NewStructAttribute))
+	return { &AuthorityStructAttributes, &AuthorityOwnerOnlyStructAttributes, &AuthoritySimulatedOnlyStructAttributes, &AuthorityUnreplicatedStructAttributes };
+}
+
+void USimpleGameplayAbilityComponent::OnFloatAttributesAdded(FFloatAttributeContainer& Container, const TArrayView<int32>& AddedIndices)
+{
+	const TArray<FFloatAttributeContainer*, TInlineAllocator<4>> AuthorityContainers = GetAuthorityFloatAttributeContainers();
+	
+	for (const int32 Index : AddedIndices)
 	{
-		LocalStructAttributes.Add(NewStructAttribute);
-		SendEvent(FDefaultTags::StructAttributeAdded(), NewStructAttribute.AttributeTag, NewStructAttribute.AttributeValue, GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+		FFloatAttribute& Attribute = Container.Attributes[Index];
+		Attribute.StoreReceivedValues();
+		PendingChangedAttributeTags.AddTag(Attribute.AttributeTag);
+
+		const int32 PredictedIndex = PredictedFloatAttributes.IndexOfByKey(Attribute);
+
+		if (PredictedIndex != INDEX_NONE)
+		{
+			CompareFloatAttributesAndSendEvents(PredictedFloatAttributes[PredictedIndex], Attribute);
+			PredictedFloatAttributes.RemoveAtSwap(PredictedIndex);
+			continue;
+		}
+
+		// The attribute moved to a container with a different replication scope that we also receive
+		if (PendingRemovedFloatAttributeTags.RemoveTag(Attribute.AttributeTag))
+		{
+			continue;
+		}
+
+		int32 ReplicatedCount = 0;
+	
+		for (const FFloatAttributeContainer* AuthorityContainer : AuthorityContainers)
+		{
+			ReplicatedCount += AuthorityContainer->Attributes.Contains(Attribute) ? 1 : 0;
+		}
+
+		if (ReplicatedCount <= 1)
+		{
+			SendEvent(FDefaultTags::FloatAttributeAdded(), Attribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+		}
 	}
 }
 
-void USimpleGameplayAbilityComponent::OnStructAttributeChanged(const FStructAttribute& ChangedStructAttribute)
+void USimpleGameplayAbilityComponent::OnFloatAttributesChanged(FFloatAttributeContainer& Container, const TArrayView<int32>& ChangedIndices)
 {
-	for (FStructAttribute& LocalStructAttribute : LocalStructAttributes)
+	for (const int32 Index : ChangedIndices)
 	{
-		if (LocalStructAttribute.AttributeTag.MatchesTagExact(ChangedStructAttribute.AttributeTag))
+		FFloatAttribute& Attribute = Container.Attributes[Index];
+		PendingChangedAttributeTags.AddTag(Attribute.AttributeTag);
+
+		// Replication wrote the new values in place, the old ones are only left in the Received fields
+		FFloatAttribute PreviousAttribute = Attribute;
+		PreviousAttribute.BaseValue = Attribute.ReceivedBaseValue;
+		PreviousAttribute.CurrentValue = Attribute.ReceivedCurrentValue;
+		PreviousAttribute.ValueLimits = Attribute.ReceivedValueLimits;
+		Attribute.StoreReceivedValues();
+
+		// Listeners saw the predicted values, so that's what the server's values are compared against
+		const int32 PredictedIndex = PredictedFloatAttributes.IndexOfByKey(Attribute);
+
+		if (PredictedIndex != INDEX_NONE)
 		{
-			FStructAttributeModification Payload;
-			Payload.AttributeOwner = this;
-			Payload.AttributeTag = ChangedStructAttribute.AttributeTag;
-			Payload.OldValue = LocalStructAttribute.AttributeValue;
-			Payload.NewValue = ChangedStructAttribute.AttributeValue;
+			CompareFloatAttributesAndSendEvents(PredictedFloatAttributes[PredictedIndex], Attribute);
+			PredictedFloatAttributes.RemoveAtSwap(PredictedIndex);
+			continue;
+		}
 
-			LocalStructAttribute = ChangedStructAttribute;
+		CompareFloatAttributesAndSendEvents(PreviousAttribute, Attribute);
+	}
+}
 
-			if (LocalStructAttribute.StructAttributeHandler)
-			{
-				Payload.ModificationTags = GetStructAttributeHandlerInstance(LocalStructAttribute.StructAttributeHandler)->GetModificationEvents(ChangedStructAttribute.AttributeTag, Payload.OldValue, Payload.NewValue);
-			}
-			
-			SendEvent(FDefaultTags::StructAttributeValueChanged(), ChangedStructAttribute.AttributeTag, FInstancedStruct::Make(Payload), this, {}, ESimpleEventReplicationPolicy::NoReplication);
-			return;
+void USimpleGameplayAbilityComponent::OnFloatAttributesRemoved(const FFloatAttributeContainer& Container, const TArrayView<int32>& RemovedIndices)
+{
+	for (const int32 Index : RemovedIndices)
+	{
+		const FFloatAttribute& Attribute = Container.Attributes[Index];
+		
+		PredictedFloatAttributes.RemoveSwap(Attribute);
+		PendingRemovedFloatAttributeTags.AddTag(Attribute.AttributeTag);
+		PendingChangedAttributeTags.AddTag(Attribute.AttributeTag);
+	}
+}
+
+void USimpleGameplayAbilityComponent::OnStructAttributesAdded(FStructAttributeContainer& Container, const TArrayView<int32>& AddedIndices)
+{
+	const TArray<FStructAttributeContainer*, TInlineAllocator<4>> AuthorityContainers = GetAuthorityStructAttributeContainers();
+	
+	for (const int32 Index : AddedIndices)
+	{
+		FStructAttribute& Attribute = Container.Attributes[Index];
+		StorePreviousStructAttributeValue(Attribute);
+		PendingChangedAttributeTags.AddTag(Attribute.AttributeTag);
+
+		const int32 PredictedIndex = PredictedStructAttributes.IndexOfByKey(Attribute);
+
+		if (PredictedIndex != INDEX_NONE)
+		{
+			SendStructAttributeChangedEvent(Attribute, MoveTemp(PredictedStructAttributes[PredictedIndex].AttributeValue));
+			PredictedStructAttributes.RemoveAtSwap(PredictedIndex);
+			continue;
+		}
+
+		// The attribute moved to a container with a different replication scope that we also receive
+		if (PendingRemovedStructAttributeTags.RemoveTag(Attribute.AttributeTag))
+		{
+			continue;
+		}
+
+		int32 ReplicatedCount = 0;
+	
+		for (const FStructAttributeContainer* AuthorityContainer : AuthorityContainers)
+		{
+			ReplicatedCount += AuthorityContainer->Attributes.Contains(Attribute) ? 1 : 0;
+		}
+
+		if (ReplicatedCount <= 1)
+		{
+			SendEvent(FDefaultTags::StructAttributeAdded(), Attribute.AttributeTag, Attribute.AttributeValue, GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
 		}
 	}
+}
+
+void USimpleGameplayAbilityComponent::OnStructAttributesChanged(FStructAttributeContainer& Container, const TArrayView<int32>& ChangedIndices)
+{
+	for (const int32 Index : ChangedIndices)
+	{
+		FStructAttribute& Attribute = Container.Attributes[Index];
+		PendingChangedAttributeTags.AddTag(Attribute.AttributeTag);
+
+		// Replication wrote the new value over the old one, the old one is only left in PreviousAttributeValue
+		FInstancedStruct OldValue = MoveTemp(Attribute.PreviousAttributeValue);
+		StorePreviousStructAttributeValue(Attribute);
+
+		// Listeners saw the predicted value, so that's what the server's value replaces
+		const int32 PredictedIndex = PredictedStructAttributes.IndexOfByKey(Attribute);
+
+		if (PredictedIndex != INDEX_NONE)
+		{
+			SendStructAttributeChangedEvent(Attribute, MoveTemp(PredictedStructAttributes[PredictedIndex].AttributeValue));
+			PredictedStructAttributes.RemoveAtSwap(PredictedIndex);
+			continue;
+		}
 
-	LocalStructAttributes.Add(ChangedStructAttribute);
-	SendEvent(FDefaultTags::StructAttributeAdded(), ChangedStructAttribute.AttributeTag, ChangedStructAttribute.AttributeValue, GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+		SendStructAttributeChangedEvent(Attribute, MoveTemp(OldValue));
+	}
+}
+
+void USimpleGameplayAbilityComponent::OnStructAttributesRemoved(FStructAttributeContainer& Container, const TArrayView<int32>& RemovedIndices)
+{
+	for (const int32 Index : RemovedIndices)
+	{
+		const FStructAttribute& Attribute = Container.Attributes[Index];
+		
+		PredictedStructAttributes.RemoveSwap(Attribute);
+		PendingRemovedStructAttributeTags.AddTag(Attribute.AttributeTag);
+		PendingChangedAttributeTags.AddTag(Attribute.AttributeTag);
+	}
+}
+
+void USimpleGameplayAbilityComponent::StorePreviousStructAttributeValue(FStructAttribute& Attribute) const
+{
+	const USimpleEventSubsystem* EventSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<USimpleEventSubsystem>();
+	
+	// Structs can be big, so only keep a copy around if the next changed event has a listener to send it to
+	if (EventSubsystem && EventSubsystem->HasListeners(FDefaultTags::StructAttributeValueChanged(), Attribute.AttributeTag))
+	{
+		Attribute.PreviousAttributeValue = Attribute.AttributeValue;
+	}
+	else
+	{
+		Attribute.PreviousAttributeValue.Reset();
+	}
 }
 
-void USimpleGameplayAbilityComponent::OnStructAttributeRemoved(const FStructAttribute& RemovedStructAttribute)
+void USimpleGameplayAbilityComponent::SendStructAttributeChangedEvent(const FStructAttribute& Attribute, FInstancedStruct&& OldValue)
 {
-	LocalStructAttributes.Remove(RemovedStructAttribute);
-	SendEvent(FDefaultTags::StructAttributeRemoved(), RemovedStructAttribute.AttributeTag, FInstancedStruct(), GetOwner(), {}, ESimpleEventReplicationPolicy::NoReplication);
+	FStructAttributeModification Payload;
+	Payload.AttributeOwner = this;
+	Payload.AttributeTag = Attribute.AttributeTag;
+	Payload.OldValue = MoveTemp(OldValue);
+	Payload.NewValue = Attribute.AttributeValue;
+
+	if (Attribute.StructAttributeHandler)
+	{
+		Payload.ModificationTags = GetStructAttributeHandlerInstance(Attribute.StructAttributeHandler)->GetModificationEvents(Attribute.AttributeTag, Payload.OldValue, Payload.NewValue);
+	}
+	
+	SendEvent(FDefaultTags::StructAttributeValueChanged(), Attribute.AttributeTag, FInstancedStruct::Make(Payload), this, {}, ESimpleEventReplicationPolicy::NoReplication);
 }
\ No newline at end of file
@@ -0,0 +1,52 @@
+#include "SimpleNetID.h"
+
+#include <atomic>
+
+FGuid FSimpleNetID::NewID(const bool IsClientID)
+{
+	// Shared by every component on this machine so IDs stay unique when abilities or modifiers are applied to other components
+	static std::atomic<uint32> NextCounter = 0;
+
+	uint32 Counter = 0;
+	
+	while (Counter == 0)
+	{
+		Counter = (NextCounter.fetch_add(1, std::memory_order_relaxed) + 1) & ~ClientPrefix;
+	}
+
+	return FromCompactID(IsClientID ? Counter | ClientPrefix : Counter);
+}
+
+void FSimpleNetID::SerializeCompactID(FArchive& Ar, uint32& CompactID)
+{
+	uint8 IsClientID = (CompactID & ClientPrefix) != 0 ? 1 : 0;
+	uint32 Counter = CompactID & ~ClientPrefix;
+	
+	Ar.SerializeBits(&IsClientID, 1);
+	Ar.SerializeIntPacked(Counter);
+
+	if (Ar.IsLoading())
+	{
+		CompactID = (Counter & ~ClientPrefix) | (IsClientID ? ClientPrefix : 0);
+	}
+}
+
+void FSimpleNetID::SerializeID(FArchive& Ar, FGuid& ID)
+{
+	uint8 IsCompactID = IsCompact(ID) ? 1 : 0;
+	Ar.SerializeBits(&IsCompactID, 1);
+
+	if (!IsCompactID)
+	{
+		Ar << ID;
+		return;
+	}
+
+	uint32 CompactID = ToCompactID(ID);
+	SerializeCompactID(Ar, CompactID);
+
+	if (Ar.IsLoading())
+	{
+		ID = FromCompactID(CompactID);
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Compact 32 bit IDs for abilities, attribute modifiers, event subscriptions and replicated events.
+ * The top bit is a prefix that says which side of the connection made the ID (0 = server, 1 = client) and the rest is
+ * a counter. IDs are stored in an FGuid with only D set so the Blueprint API keeps working with FGuids, and are much
+ * cheaper to make than FGuid::NewGuid.
+ *
+ * One prefix bit is enough because IDs are only ever looked up on a single component: a component only takes client IDs
+ * from its owning connection, and the server forces the client prefix on them (see ToClientID). The counter is shared by
+ * every component in the process so IDs stay unique when modifiers or abilities are applied across components.
+ */
+struct SIMPLEGAMEPLAYABILITYSYSTEM_API FSimpleNetID
+{
+	static constexpr uint32 ClientPrefix = 0x80000000;
+
+	/* Makes a new compact ID. Client IDs never collide with server IDs. */
+	static FGuid NewID(bool IsClientID = false);
+	
+	static FGuid FromCompactID(const uint32 CompactID) { return FGuid(0, 0, 0, CompactID); }
+	static uint32 ToCompactID(const FGuid& ID) { return ID.D; }
+	static bool IsCompact(const FGuid& ID) { return ID.A == 0 && ID.B == 0 && ID.C == 0 && ID.D != 0; }
+
+	/* Gives a compact ID the client prefix. The server calls this on every ID a client sends so it can't collide with server IDs. */
+	static FGuid ToClientID(const FGuid& ID) { return IsCompact(ID) ? FromCompactID(ToCompactID(ID) | ClientPrefix) : ID; }
+
+	/* Sends the prefix bit and the counter packed so recent IDs only take a couple of bytes. */
+	static void SerializeCompactID(FArchive& Ar, uint32& CompactID);
+	
+	/* Sends compact IDs with SerializeCompactID and any other FGuid in full. */
+	static void SerializeID(FArchive& Ar, FGuid& ID);
+};
@@ -33,10 +33,15 @@ public class SimpleGameplayAbilitySystem : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"AIModule",
+				"Json",
 			}
 			);
 		
 		
 		DynamicallyLoadedModuleNames.AddRange(new string[] { });
+		
+		// Adds IrisCore and defines UE_WITH_IRIS when the target is built with Iris
+		SetupIrisSupport(Target);
 	}
 }
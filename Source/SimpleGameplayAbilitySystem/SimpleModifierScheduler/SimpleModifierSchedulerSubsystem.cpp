@@ -0,0 +1,338 @@
+#include "SimpleModifierSchedulerSubsystem.h"
+
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAttributeModifier/SimpleAttributeModifier.h"
+
+void USimpleModifierSchedulerSubsystem::RegisterModifier(USimpleAttributeModifier* Modifier, const float Duration, const float TickInterval)
+{
+	if (!Modifier || (Duration <= 0.0f && TickInterval <= 0.0f))
+	{
+		return;
+	}
+
+	UnregisterModifier(Modifier);
+
+	const double CurrentTime = GetSchedulerTime();
+	FScheduledModifier& ScheduledModifier = ScheduledModifiers.Add(Modifier);
+	ScheduledModifier.RegistrationSerial = ++NextRegistrationSerial;
+	ScheduledModifier.RegisterTime = CurrentTime;
+
+	if (TickInterval > 0.0f)
+	{
+		FSimpleModifierTickBucket& TickBucket = TickBuckets.FindOrAdd(TickInterval);
+
+		FSimpleModifierTickEntry TickEntry;
+		TickEntry.Modifier = Modifier;
+		TickEntry.RegistrationSerial = ScheduledModifier.RegistrationSerial;
+		TickEntry.NextTickTime = CurrentTime + TickInterval;
+
+		ScheduledModifier.TickInterval = TickInterval;
+		ScheduledModifier.TickEntryIndex = TickBucket.Entries.Add(TickEntry);
+		TickBucket.NextDueTime = FMath::Min(TickBucket.NextDueTime, TickEntry.NextTickTime);
+	}
+
+	if (Duration > 0.0f)
+	{
+		ScheduledModifier.ExpiryTime = CurrentTime + Duration;
+		ScheduleExpiry(Modifier, ScheduledModifier);
+	}
+}
+
+void USimpleModifierSchedulerSubsystem::UnregisterModifier(USimpleAttributeModifier* Modifier)
+{
+	FScheduledModifier ScheduledModifier;
+
+	if (!ScheduledModifiers.RemoveAndCopyValue(Modifier, ScheduledModifier))
+	{
+		return;
+	}
+
+	if (ScheduledModifier.ExpiryTimerHandle != 0)
+	{
+		ExpiryWheel.CancelTimer(ScheduledModifier.ExpiryTimerHandle);
+	}
+
+	if (FSimpleModifierTickBucket* TickBucket = TickBuckets.Find(ScheduledModifier.TickInterval))
+	{
+		if (TickBucket->Entries.IsValidIndex(ScheduledModifier.TickEntryIndex))
+		{
+			// Only clear the entry here since this can be called while modifiers are being ticked. It's removed after the next tick.
+			FSimpleModifierTickEntry& TickEntry = TickBucket->Entries[ScheduledModifier.TickEntryIndex];
+			TickEntry.Modifier.Reset();
+			TickEntry.IsPaused = true;
+			TickBucket->HasStaleEntries = true;
+		}
+	}
+}
+
+void USimpleModifierSchedulerSubsystem::SetModifierPaused(USimpleAttributeModifier* Modifier, const bool IsPaused)
+{
+	FScheduledModifier* ScheduledModifier = ScheduledModifiers.Find(Modifier);
+
+	if (!ScheduledModifier || ScheduledModifier->IsPaused == IsPaused)
+	{
+		return;
+	}
+
+	const double CurrentTime = GetSchedulerTime();
+	ScheduledModifier->IsPaused = IsPaused;
+
+	FSimpleModifierTickBucket* TickBucket = TickBuckets.Find(ScheduledModifier->TickInterval);
+	FSimpleModifierTickEntry* TickEntry = TickBucket && TickBucket->Entries.IsValidIndex(ScheduledModifier->TickEntryIndex)
+		? &TickBucket->Entries[ScheduledModifier->TickEntryIndex]
+		: nullptr;
+
+	if (IsPaused)
+	{
+		ScheduledModifier->PauseTime = CurrentTime;
+
+		if (TickEntry)
+		{
+			TickEntry->IsPaused = true;
+		}
+
+		if (ScheduledModifier->ExpiryTimerHandle != 0)
+		{
+			ExpiryWheel.CancelTimer(ScheduledModifier->ExpiryTimerHandle);
+			ScheduledModifier->ExpiryTimerHandle = 0;
+		}
+
+		return;
+	}
+
+	// Everything that was pending is pushed back by the time spent paused
+	const double PausedTime = CurrentTime - ScheduledModifier->PauseTime;
+	ScheduledModifier->TotalPausedTime += PausedTime;
+
+	if (TickEntry)
+	{
+		TickEntry->IsPaused = false;
+		TickEntry->NextTickTime += PausedTime;
+		TickBucket->NextDueTime = FMath::Min(TickBucket->NextDueTime, TickEntry->NextTickTime);
+	}
+
+	if (ScheduledModifier->ExpiryTime > 0.0)
+	{
+		ScheduledModifier->ExpiryTime += PausedTime;
+		ScheduleExpiry(Modifier, *ScheduledModifier);
+	}
+}
+
+void USimpleModifierSchedulerSubsystem::SetModifierDuration(USimpleAttributeModifier* Modifier, const float RemainingDuration)
+{
+	FScheduledModifier* ScheduledModifier = ScheduledModifiers.Find(Modifier);
+
+	if (!ScheduledModifier)
+	{
+		return;
+	}
+
+	if (ScheduledModifier->ExpiryTimerHandle != 0)
+	{
+		ExpiryWheel.CancelTimer(ScheduledModifier->ExpiryTimerHandle);
+		ScheduledModifier->ExpiryTimerHandle = 0;
+	}
+
+	// A paused modifier gets its expiry scheduled when it's unpaused
+	const double ReferenceTime = ScheduledModifier->IsPaused ? ScheduledModifier->PauseTime : GetSchedulerTime();
+	ScheduledModifier->ExpiryTime = ReferenceTime + FMath::Max(RemainingDuration, 0.0f);
+
+	if (!ScheduledModifier->IsPaused)
+	{
+		ScheduleExpiry(Modifier, *ScheduledModifier);
+	}
+}
+
+float USimpleModifierSchedulerSubsystem::GetModifierRemainingDuration(const USimpleAttributeModifier* Modifier) const
+{
+	const FScheduledModifier* ScheduledModifier = ScheduledModifiers.Find(Modifier);
+
+	if (!ScheduledModifier || ScheduledModifier->ExpiryTime <= 0.0)
+	{
+		return 0.0f;
+	}
+
+	const double ReferenceTime = ScheduledModifier->IsPaused ? ScheduledModifier->PauseTime : GetSchedulerTime();
+	return static_cast<float>(FMath::Max(ScheduledModifier->ExpiryTime - ReferenceTime, 0.0));
+}
+
+float USimpleModifierSchedulerSubsystem::GetModifierActiveTime(const USimpleAttributeModifier* Modifier) const
+{
+	const FScheduledModifier* ScheduledModifier = ScheduledModifiers.Find(Modifier);
+
+	if (!ScheduledModifier)
+	{
+		return 0.0f;
+	}
+
+	const double ReferenceTime = ScheduledModifier->IsPaused ? ScheduledModifier->PauseTime : GetSchedulerTime();
+	return static_cast<float>(ReferenceTime - ScheduledModifier->RegisterTime - ScheduledModifier->TotalPausedTime);
+}
+
+void USimpleModifierSchedulerSubsystem::Deinitialize()
+{
+	TickBuckets.Empty();
+	ScheduledModifiers.Empty();
+	ExpiryWheel.Reset();
+	DueModifiers.Empty();
+	Super::Deinitialize();
+}
+
+void USimpleModifierSchedulerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (ScheduledModifiers.Num() == 0)
+	{
+		LastTickCycles = 0;
+		return;
+	}
+
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+	const double CurrentTime = GetSchedulerTime();
+
+	for (TPair<float, FSimpleModifierTickBucket>& TickBucketPair : TickBuckets)
+	{
+		FSimpleModifierTickBucket& TickBucket = TickBucketPair.Value;
+
+		if (CurrentTime < TickBucket.NextDueTime)
+		{
+			continue;
+		}
+
+		const double TickInterval = TickBucketPair.Key;
+		double NextDueTime = TNumericLimits<double>::Max();
+
+		for (FSimpleModifierTickEntry& TickEntry : TickBucket.Entries)
+		{
+			if (TickEntry.IsPaused)
+			{
+				continue;
+			}
+
+			// A long frame can tick a modifier more than once, same as a looping engine timer would
+			while (TickEntry.NextTickTime <= CurrentTime)
+			{
+				DueModifiers.Emplace(TickEntry.Modifier, TickEntry.RegistrationSerial);
+				TickEntry.NextTickTime += TickInterval;
+			}
+
+			NextDueTime = FMath::Min(NextDueTime, TickEntry.NextTickTime);
+		}
+
+		TickBucket.NextDueTime = NextDueTime;
+	}
+
+	// Modifiers are ticked after the buckets are updated since a tick can apply, pause or end modifiers
+	for (const TPair<TWeakObjectPtr<USimpleAttributeModifier>, uint32>& DueModifier : DueModifiers)
+	{
+		if (USimpleAttributeModifier* Modifier = DueModifier.Key.Get())
+		{
+			if (Modifier->IsModifierActive() && IsCurrentRegistration(Modifier, DueModifier.Value))
+			{
+				Modifier->TickDurationModifier();
+			}
+		}
+	}
+
+	DueModifiers.Reset();
+
+	// Expiry runs after ticking so a modifier whose duration is a multiple of its tick interval gets its last tick
+	if (ExpiryWheel.Num() > 0)
+	{
+		ExpiryWheel.Advance(CurrentTime);
+	}
+
+	CompactBuckets();
+
+	LastTickCycles = FPlatformTime::Cycles64() - StartCycles;
+}
+
+TStatId USimpleModifierSchedulerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleModifierSchedulerSubsystem, STATGROUP_Tickables);
+}
+
+double USimpleModifierSchedulerSubsystem::GetSchedulerTime() const
+{
+	// World time so modifiers keep following time dilation and game pause like the engine timers did
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void USimpleModifierSchedulerSubsystem::ScheduleExpiry(USimpleAttributeModifier* Modifier, FScheduledModifier& ScheduledModifier)
+{
+	ScheduledModifier.ExpiryTimerHandle = ExpiryWheel.ScheduleTimer(
+		ScheduledModifier.ExpiryTime,
+		FSimpleTimerDelegate::CreateUObject(this, &USimpleModifierSchedulerSubsystem::ExpireModifier, TObjectKey<USimpleAttributeModifier>(Modifier), ScheduledModifier.RegistrationSerial));
+}
+
+void USimpleModifierSchedulerSubsystem::ExpireModifier(TObjectKey<USimpleAttributeModifier> ModifierKey, const uint32 RegistrationSerial)
+{
+	FScheduledModifier* ScheduledModifier = ScheduledModifiers.Find(ModifierKey);
+
+	// The wheel collects all due timers before running them, so an earlier expiry can end this modifier and a reapply
+	// can register it again (or move its expiry) before this timer runs
+	if (!ScheduledModifier || ScheduledModifier->RegistrationSerial != RegistrationSerial ||
+		ScheduledModifier->IsPaused || ScheduledModifier->ExpiryTime > GetSchedulerTime())
+	{
+		return;
+	}
+
+	ScheduledModifier->ExpiryTimerHandle = 0;
+	USimpleAttributeModifier* Modifier = ModifierKey.ResolveObjectPtr();
+
+	if (!Modifier)
+	{
+		ScheduledModifiers.Remove(ModifierKey);
+		return;
+	}
+
+	// Either drops expired stacks and sets a new duration or ends the modifier, which unregisters it
+	Modifier->ExpireDuration();
+}
+
+bool USimpleModifierSchedulerSubsystem::IsCurrentRegistration(const USimpleAttributeModifier* Modifier, const uint32 RegistrationSerial) const
+{
+	const FScheduledModifier* ScheduledModifier = ScheduledModifiers.Find(Modifier);
+	return ScheduledModifier && ScheduledModifier->RegistrationSerial == RegistrationSerial;
+}
+
+void USimpleModifierSchedulerSubsystem::CompactBuckets()
+{
+	for (TPair<float, FSimpleModifierTickBucket>& TickBucketPair : TickBuckets)
+	{
+		FSimpleModifierTickBucket& TickBucket = TickBucketPair.Value;
+
+		if (!TickBucket.HasStaleEntries)
+		{
+			continue;
+		}
+
+		int32 NumKeptEntries = 0;
+
+		for (int32 i = 0; i < TickBucket.Entries.Num(); i++)
+		{
+			USimpleAttributeModifier* Modifier = TickBucket.Entries[i].Modifier.Get();
+
+			if (!Modifier)
+			{
+				continue;
+			}
+
+			if (i != NumKeptEntries)
+			{
+				TickBucket.Entries[NumKeptEntries] = TickBucket.Entries[i];
+
+				if (FScheduledModifier* ScheduledModifier = ScheduledModifiers.Find(Modifier))
+				{
+					ScheduledModifier->TickEntryIndex = NumKeptEntries;
+				}
+			}
+
+			NumKeptEntries++;
+		}
+
+		TickBucket.Entries.SetNum(NumKeptEntries);
+		TickBucket.HasStaleEntries = false;
+	}
+}
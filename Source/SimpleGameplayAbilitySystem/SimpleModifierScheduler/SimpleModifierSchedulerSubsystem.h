@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SimpleGameplayAbilitySystem/SimpleTimerSubsystem/SimpleTimerWheel.h"
+#include "SimpleModifierSchedulerSubsystem.generated.h"
+
+class USimpleAttributeModifier;
+
+USTRUCT()
+struct FSimpleModifierTickEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TWeakObjectPtr<USimpleAttributeModifier> Modifier;
+
+	// See FScheduledModifier::RegistrationSerial
+	uint32 RegistrationSerial = 0;
+	
+	double NextTickTime = 0.0;
+	bool IsPaused = false;
+};
+
+/* All duration modifiers that share a tick interval. Ticks are checked in one pass over the bucket once the earliest one is due. */
+USTRUCT()
+struct FSimpleModifierTickBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FSimpleModifierTickEntry> Entries;
+
+	// The earliest NextTickTime of an unpaused entry. The bucket is skipped until then.
+	double NextDueTime = TNumericLimits<double>::Max();
+
+	// Set when a modifier unregisters so the bucket gets compacted after the next tick
+	bool HasStaleEntries = false;
+};
+
+/**
+ * Runs the ticks and expiry of every active duration modifier in the world.
+ * Ticking modifiers are grouped into buckets by tick interval and expiry goes through a timer wheel,
+ * so thousands of damage/heal over time modifiers cost a few array passes per frame instead of two engine timers each.
+ */
+UCLASS()
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleModifierSchedulerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Starts ticking and/or expiring a duration modifier.
+	 * @param Modifier The modifier to schedule
+	 * @param Duration Seconds until the modifier ends successfully. 0 or less never expires.
+	 * @param TickInterval Seconds between ticks. 0 or less never ticks.
+	 */
+	void RegisterModifier(USimpleAttributeModifier* Modifier, float Duration, float TickInterval);
+	void UnregisterModifier(USimpleAttributeModifier* Modifier);
+
+	/* Paused modifiers don't tick and their remaining duration is frozen until they're unpaused. */
+	void SetModifierPaused(USimpleAttributeModifier* Modifier, bool IsPaused);
+
+	/* Moves the expiry of a scheduled modifier to RemainingDuration seconds from now, not counting time spent paused. */
+	void SetModifierDuration(USimpleAttributeModifier* Modifier, float RemainingDuration);
+
+	/* Seconds until the modifier expires. 0 if it isn't scheduled to expire. */
+	float GetModifierRemainingDuration(const USimpleAttributeModifier* Modifier) const;
+
+	/* Seconds since the modifier was registered, not counting time spent paused. */
+	float GetModifierActiveTime(const USimpleAttributeModifier* Modifier) const;
+
+	int32 GetNumScheduledModifiers() const { return ScheduledModifiers.Num(); }
+
+	/* How long the last tick of the scheduler took, including the modifier ticks and expiries it ran. */
+	uint64 GetLastTickCycles() const { return LastTickCycles; }
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	struct FScheduledModifier
+	{
+		// Pooled modifiers are registered again after they end, ticks and expiries queued for an earlier registration are ignored
+		uint32 RegistrationSerial = 0;
+		float TickInterval = 0.0f;
+		int32 TickEntryIndex = INDEX_NONE;
+		uint64 ExpiryTimerHandle = 0;
+		// 0 if the modifier doesn't expire
+		double ExpiryTime = 0.0;
+		double RegisterTime = 0.0;
+		double PauseTime = 0.0;
+		double TotalPausedTime = 0.0;
+		bool IsPaused = false;
+	};
+
+	double GetSchedulerTime() const;
+	void ScheduleExpiry(USimpleAttributeModifier* Modifier, FScheduledModifier& ScheduledModifier);
+	void ExpireModifier(TObjectKey<USimpleAttributeModifier> ModifierKey, uint32 RegistrationSerial);
+	bool IsCurrentRegistration(const USimpleAttributeModifier* Modifier, uint32 RegistrationSerial) const;
+	void CompactBuckets();
+
+	UPROPERTY()
+	TMap<float, FSimpleModifierTickBucket> TickBuckets;
+
+	TMap<TObjectKey<USimpleAttributeModifier>, FScheduledModifier> ScheduledModifiers;
+	FSimpleTimerWheel ExpiryWheel;
+
+	// Reused every tick so collecting the due modifiers doesn't allocate
+	TArray<TPair<TWeakObjectPtr<USimpleAttributeModifier>, uint32>> DueModifiers;
+
+	uint32 NextRegistrationSerial = 0;
+
+	uint64 LastTickCycles = 0;
+};
@@ -0,0 +1,448 @@
+#include "SimpleNetBenchmarkSubsystem.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAttributeModifier/SimpleAttributeModifier.h"
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleGameplayAbility/SimpleGameplayAbility.h"
+#include "SimpleGameplayAbilitySystem/SimpleGameplayAbilityComponent/SimpleGameplayAbilityComponent.h"
+#include "SimpleGameplayAbilitySystem/SimpleModifierScheduler/SimpleModifierSchedulerSubsystem.h"
+
+// The benchmark drives gameplay from the console, so neither the command nor the subsystem exist in shipping builds
+#if !UE_BUILD_SHIPPING
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+	TEXT("SimpleGAS.Benchmark"),
+	TEXT("Runs a replication benchmark on the server's ability components and writes the results to Saved/Profiling/SimpleGAS.\n")
+	TEXT("SimpleGAS.Benchmark Start Scenario=<ActivationStorm|DurationModifiers|TagChurn|StructAttributeEdits> [Duration=30] [Rate=10] [Targets=0] ")
+	TEXT("[Ability=<class path>] [Policy=<activation policy>] [Modifier=<class path>] [Tag=<gameplay tag>] [Attribute=<attribute tag>]\n")
+	TEXT("SimpleGAS.Benchmark Stop"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		USimpleNetBenchmarkSubsystem* BenchmarkSubsystem = World ? World->GetSubsystem<USimpleNetBenchmarkSubsystem>() : nullptr;
+
+		if (!BenchmarkSubsystem || Args.Num() == 0)
+		{
+			return;
+		}
+
+		if (Args[0] == TEXT("Stop"))
+		{
+			BenchmarkSubsystem->StopBenchmark();
+			return;
+		}
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+		FSimpleNetBenchmarkSettings Settings;
+
+		FString ScenarioName;
+		FParse::Value(*Params, TEXT("Scenario="), ScenarioName);
+		const int64 Scenario = StaticEnum<ESimpleNetBenchmarkScenario>()->GetValueByNameString(ScenarioName);
+
+		if (Scenario == INDEX_NONE)
+		{
+			UE_LOG(LogSimpleGAS, Warning, TEXT("SimpleGAS.Benchmark: Unknown scenario '%s'."), *ScenarioName);
+			return;
+		}
+
+		Settings.Scenario = static_cast<ESimpleNetBenchmarkScenario>(Scenario);
+		FParse::Value(*Params, TEXT("Duration="), Settings.Duration);
+		FParse::Value(*Params, TEXT("Rate="), Settings.OperationsPerSecond);
+		FParse::Value(*Params, TEXT("Targets="), Settings.MaxTargets);
+
+		FString Value;
+
+		if (FParse::Value(*Params, TEXT("Ability="), Value))
+		{
+			Settings.AbilityClass = LoadClass<USimpleGameplayAbility>(nullptr, *Value);
+		}
+
+		if (FParse::Value(*Params, TEXT("Policy="), Value))
+		{
+			const int64 Policy = StaticEnum<EAbilityActivationPolicy>()->GetValueByNameString(Value);
+
+			if (Policy == INDEX_NONE)
+			{
+				UE_LOG(LogSimpleGAS, Warning, TEXT("SimpleGAS.Benchmark: Unknown activation policy '%s'."), *Value);
+				return;
+			}
+
+			Settings.OverrideActivationPolicy = true;
+			Settings.ActivationPolicy = static_cast<EAbilityActivationPolicy>(Policy);
+		}
+
+		if (FParse::Value(*Params, TEXT("Modifier="), Value))
+		{
+			Settings.ModifierClass = LoadClass<USimpleAttributeModifier>(nullptr, *Value);
+		}
+
+		if (FParse::Value(*Params, TEXT("Tag="), Value))
+		{
+			Settings.GameplayTag = FGameplayTag::RequestGameplayTag(FName(*Value), false);
+		}
+
+		if (FParse::Value(*Params, TEXT("Attribute="), Value))
+		{
+			Settings.AttributeTag = FGameplayTag::RequestGameplayTag(FName(*Value), false);
+		}
+
+		BenchmarkSubsystem->StartBenchmark(Settings);
+	}));
+
+bool USimpleNetBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return Super::ShouldCreateSubsystem(Outer);
+}
+
+bool USimpleNetBenchmarkSubsystem::StartBenchmark(const FSimpleNetBenchmarkSettings& InSettings)
+{
+	UWorld* World = GetWorld();
+
+	if (Running || !World || World->GetNetMode() == NM_Client)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleNetBenchmarkSubsystem::StartBenchmark]: The benchmark can only be started on the server and only once at a time."));
+		return false;
+	}
+
+	const bool HasRequiredSettings =
+		(InSettings.Scenario != ESimpleNetBenchmarkScenario::ActivationStorm || InSettings.AbilityClass) &&
+		(InSettings.Scenario != ESimpleNetBenchmarkScenario::DurationModifiers || InSettings.ModifierClass) &&
+		(InSettings.Scenario != ESimpleNetBenchmarkScenario::TagChurn || InSettings.GameplayTag.IsValid()) &&
+		(InSettings.Scenario != ESimpleNetBenchmarkScenario::StructAttributeEdits || InSettings.AttributeTag.IsValid());
+
+	if (!HasRequiredSettings || InSettings.Duration <= 0.0f || InSettings.OperationsPerSecond <= 0.0f)
+	{
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleNetBenchmarkSubsystem::StartBenchmark]: Scenario %s is missing its ability, modifier or tag, or has no duration or rate."),
+			*StaticEnum<ESimpleNetBenchmarkScenario>()->GetNameStringByValue(static_cast<int64>(InSettings.Scenario))));
+		return false;
+	}
+
+	Settings = InSettings;
+	Targets.Reset();
+
+	for (TObjectIterator<USimpleGameplayAbilityComponent> It; It; ++It)
+	{
+		if (It->GetWorld() == World && It->HasAuthority() && !It->IsTemplate())
+		{
+			Targets.Add(*It);
+
+			if (Settings.MaxTargets > 0 && Targets.Num() >= Settings.MaxTargets)
+			{
+				break;
+			}
+		}
+	}
+
+	if (Targets.IsEmpty())
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleNetBenchmarkSubsystem::StartBenchmark]: No ability components found to drive."));
+		return false;
+	}
+
+	ConnectionSamples.Reset();
+	RPCCounts.Reset();
+	Operations = 0;
+	FailedOperations = 0;
+	ComponentCycles = 0;
+	SchedulerCycles = 0;
+	PeakScheduledModifiers = 0;
+	FrameTimeSum = 0.0;
+	Frames = 0;
+	OperationBudget = 0.0;
+	StartTime = FPlatformTime::Seconds();
+
+	SampleConnections();
+
+	// The engine only has room for one RPC hook, so leave it alone if something else is using it
+	UNetDriver* NetDriver = World->GetNetDriver();
+	IsCountingRPCs = NetDriver && !NetDriver->SendRPCDel.IsBound();
+
+	if (IsCountingRPCs)
+	{
+		NetDriver->SendRPCDel.BindUObject(this, &USimpleNetBenchmarkSubsystem::OnSendRPC);
+	}
+
+	Running = true;
+
+	UE_LOG(LogSimpleGAS, Log, TEXT("SimpleGAS.Benchmark: Running %s on %d ability components for %.1f seconds."),
+		*StaticEnum<ESimpleNetBenchmarkScenario>()->GetNameStringByValue(static_cast<int64>(Settings.Scenario)), Targets.Num(), Settings.Duration);
+
+	return true;
+}
+
+void USimpleNetBenchmarkSubsystem::StopBenchmark()
+{
+	if (!Running)
+	{
+		return;
+	}
+
+	SampleConnections();
+	WriteResults(FPlatformTime::Seconds() - StartTime);
+
+	if (IsCountingRPCs)
+	{
+		if (UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr)
+		{
+			NetDriver->SendRPCDel.Unbind();
+		}
+	}
+
+	IsCountingRPCs = false;
+	Running = false;
+	Targets.Reset();
+	ConnectionSamples.Reset();
+}
+
+void USimpleNetBenchmarkSubsystem::Deinitialize()
+{
+	StopBenchmark();
+	Super::Deinitialize();
+}
+
+void USimpleNetBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!Running)
+	{
+		return;
+	}
+
+	FrameTimeSum += DeltaTime;
+	Frames++;
+
+	// Operations are spread over frames, so a rate higher than the frame rate does several per frame
+	OperationBudget += Settings.OperationsPerSecond * DeltaTime;
+	const int32 NumOperations = FMath::FloorToInt32(OperationBudget);
+	OperationBudget -= NumOperations;
+
+	if (NumOperations > 0)
+	{
+		const uint64 StartCycles = FPlatformTime::Cycles64();
+
+		for (const TWeakObjectPtr<USimpleGameplayAbilityComponent>& Target : Targets)
+		{
+			if (Target.IsValid())
+			{
+				DriveTarget(Target.Get(), NumOperations);
+			}
+		}
+
+		ComponentCycles += FPlatformTime::Cycles64() - StartCycles;
+	}
+
+	// Duration modifiers tick and expire in the scheduler, so their cost shows up there rather than in the component calls
+	if (const USimpleModifierSchedulerSubsystem* ModifierScheduler = GetWorld()->GetSubsystem<USimpleModifierSchedulerSubsystem>())
+	{
+		SchedulerCycles += ModifierScheduler->GetLastTickCycles();
+		PeakScheduledModifiers = FMath::Max(PeakScheduledModifiers, ModifierScheduler->GetNumScheduledModifiers());
+	}
+
+	// Connections that join mid run are picked up here, their bytes are counted from when they were first seen
+	SampleConnections();
+
+	if (FPlatformTime::Seconds() - StartTime >= Settings.Duration)
+	{
+		StopBenchmark();
+	}
+}
+
+TStatId USimpleNetBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleNetBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+void USimpleNetBenchmarkSubsystem::DriveTarget(USimpleGameplayAbilityComponent* Target, const int32 NumOperations)
+{
+	for (int32 i = 0; i < NumOperations; i++)
+	{
+		bool Succeeded = true;
+
+		switch (Settings.Scenario)
+		{
+			case ESimpleNetBenchmarkScenario::ActivationStorm:
+			{
+				FGuid AbilityID;
+				Succeeded = Target->ActivateAbility(Settings.AbilityClass, FInstancedStruct(), AbilityID, Settings.OverrideActivationPolicy, Settings.ActivationPolicy);
+				break;
+			}
+			case ESimpleNetBenchmarkScenario::DurationModifiers:
+			{
+				FGuid ModifierID;
+				Succeeded = Target->ApplyAttributeModifierToSelf(Settings.ModifierClass, FInstancedStruct(), ModifierID);
+				break;
+			}
+			case ESimpleNetBenchmarkScenario::TagChurn:
+			{
+				if (Target->HasGameplayTag(Settings.GameplayTag))
+				{
+					Target->RemoveGameplayTag(Settings.GameplayTag, FInstancedStruct());
+				}
+				else
+				{
+					Target->AddGameplayTag(Settings.GameplayTag, FInstancedStruct());
+				}
+				break;
+			}
+			case ESimpleNetBenchmarkScenario::StructAttributeEdits:
+			{
+				bool WasFound = false;
+				const FInstancedStruct Value = Target->GetStructAttributeValue(Settings.AttributeTag, WasFound);
+				Succeeded = WasFound && Target->SetStructAttributeValue(Settings.AttributeTag, Value);
+				break;
+			}
+		}
+
+		Operations++;
+		FailedOperations += Succeeded ? 0 : 1;
+	}
+}
+
+void USimpleNetBenchmarkSubsystem::SampleConnections()
+{
+	const UNetDriver* NetDriver = GetWorld() ? GetWorld()->GetNetDriver() : nullptr;
+
+	if (!NetDriver)
+	{
+		return;
+	}
+
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		if (!Connection)
+		{
+			continue;
+		}
+
+		FConnectionSample* Sample = ConnectionSamples.Find(Connection);
+
+		if (!Sample)
+		{
+			Sample = &ConnectionSamples.Add(Connection);
+			Sample->Name = Connection->PlayerController ? Connection->PlayerController->GetName() : Connection->LowLevelGetRemoteAddress(true);
+			Sample->StartOutBytes = Connection->OutTotalBytes;
+		}
+
+		Sample->LastOutBytes = Connection->OutTotalBytes;
+	}
+}
+
+void USimpleNetBenchmarkSubsystem::OnSendRPC(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& BlockSendRPC)
+{
+	if (Function)
+	{
+		RPCCounts.FindOrAdd(FName(*FString::Printf(TEXT("%s::%s"), *GetNameSafe(Function->GetOwnerClass()), *Function->GetName())))++;
+	}
+}
+
+void USimpleNetBenchmarkSubsystem::WriteResults(const double ElapsedTime)
+{
+	const TSharedRef<FJsonObject> Results = MakeShared<FJsonObject>();
+	const double SafeElapsedTime = FMath::Max(ElapsedTime, 0.001);
+	const double ComponentMilliseconds = FPlatformTime::ToMilliseconds64(ComponentCycles);
+
+	Results->SetStringField(TEXT("Scenario"), StaticEnum<ESimpleNetBenchmarkScenario>()->GetNameStringByValue(static_cast<int64>(Settings.Scenario)));
+
+	if (Settings.Scenario == ESimpleNetBenchmarkScenario::ActivationStorm && Settings.AbilityClass)
+	{
+		const EAbilityActivationPolicy ActivationPolicy = Settings.OverrideActivationPolicy ? Settings.ActivationPolicy : Settings.AbilityClass.GetDefaultObject()->ActivationPolicy;
+		Results->SetStringField(TEXT("ActivationPolicy"), StaticEnum<EAbilityActivationPolicy>()->GetNameStringByValue(static_cast<int64>(ActivationPolicy)));
+	}
+	Results->SetNumberField(TEXT("Duration"), ElapsedTime);
+	Results->SetNumberField(TEXT("Targets"), Targets.Num());
+	Results->SetNumberField(TEXT("OperationsPerSecondPerTarget"), Settings.OperationsPerSecond);
+	Results->SetNumberField(TEXT("Operations"), Operations);
+	Results->SetNumberField(TEXT("FailedOperations"), FailedOperations);
+	Results->SetNumberField(TEXT("ComponentMilliseconds"), ComponentMilliseconds);
+	Results->SetNumberField(TEXT("ComponentMicrosecondsPerOperation"), Operations > 0 ? ComponentMilliseconds * 1000.0 / Operations : 0.0);
+	Results->SetNumberField(TEXT("ModifierSchedulerMilliseconds"), FPlatformTime::ToMilliseconds64(SchedulerCycles));
+	Results->SetNumberField(TEXT("PeakScheduledModifiers"), PeakScheduledModifiers);
+	Results->SetNumberField(TEXT("AverageServerFrameMilliseconds"), Frames > 0 ? FrameTimeSum * 1000.0 / Frames : 0.0);
+
+	TArray<TSharedPtr<FJsonValue>> Connections;
+	int64 TotalBytes = 0;
+
+	for (const TPair<TWeakObjectPtr<UNetConnection>, FConnectionSample>& ConnectionSample : ConnectionSamples)
+	{
+		const FConnectionSample& Sample = ConnectionSample.Value;
+		const int64 BytesSent = Sample.LastOutBytes - Sample.StartOutBytes;
+		TotalBytes += BytesSent;
+
+		const TSharedRef<FJsonObject> Connection = MakeShared<FJsonObject>();
+		Connection->SetStringField(TEXT("Name"), Sample.Name);
+		Connection->SetNumberField(TEXT("BytesSent"), BytesSent);
+		Connection->SetNumberField(TEXT("BytesPerSecond"), BytesSent / SafeElapsedTime);
+		Connections.Add(MakeShared<FJsonValueObject>(Connection));
+	}
+
+	Results->SetArrayField(TEXT("Connections"), Connections);
+	Results->SetNumberField(TEXT("TotalBytesPerSecond"), TotalBytes / SafeElapsedTime);
+
+	// Left out instead of reported as zero when another RPC hook was already bound
+	if (IsCountingRPCs)
+	{
+		const TSharedRef<FJsonObject> RPCs = MakeShared<FJsonObject>();
+
+		for (const TPair<FName, int32>& RPCCount : RPCCounts)
+		{
+			RPCs->SetNumberField(RPCCount.Key.ToString(), RPCCount.Value);
+		}
+
+		Results->SetObjectField(TEXT("RPCs"), RPCs);
+	}
+
+	FString ResultsString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultsString);
+	FJsonSerializer::Serialize(Results, Writer);
+
+	const FString FilePath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("SimpleGAS"),
+		FString::Printf(TEXT("Benchmark-%s-%s.json"), *Results->GetStringField(TEXT("Scenario")), *FDateTime::Now().ToString()));
+
+	if (!FFileHelper::SaveStringToFile(ResultsString, *FilePath))
+	{
+		SIMPLE_LOG(this, FString::Printf(TEXT("[USimpleNetBenchmarkSubsystem::WriteResults]: Couldn't write %s."), *FilePath));
+		return;
+	}
+
+	UE_LOG(LogSimpleGAS, Log, TEXT("SimpleGAS.Benchmark: %d operations, %.1f bytes/s sent, %.2f ms in ability components. Results written to %s"),
+		Operations, TotalBytes / SafeElapsedTime, ComponentMilliseconds, *FilePath);
+}
+
+#else
+
+bool USimpleNetBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return false;
+}
+
+bool USimpleNetBenchmarkSubsystem::StartBenchmark(const FSimpleNetBenchmarkSettings& InSettings)
+{
+	return false;
+}
+
+void USimpleNetBenchmarkSubsystem::StopBenchmark()
+{
+}
+
+void USimpleNetBenchmarkSubsystem::Deinitialize()
+{
+	Super::Deinitialize();
+}
+
+void USimpleNetBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+}
+
+TStatId USimpleNetBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleNetBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+#endif
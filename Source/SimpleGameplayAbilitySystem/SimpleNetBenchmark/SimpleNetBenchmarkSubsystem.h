@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SimpleGameplayAbilitySystem/SimpleAbility/SimpleAbilityTypes.h"
+#include "SimpleNetBenchmarkSubsystem.generated.h"
+
+struct FFrame;
+struct FOutParmRec;
+class UNetConnection;
+class USimpleAttributeModifier;
+class USimpleGameplayAbility;
+class USimpleGameplayAbilityComponent;
+
+UENUM()
+enum class ESimpleNetBenchmarkScenario : uint8
+{
+	// Every target activates AbilityClass
+	ActivationStorm,
+	// Every target applies ModifierClass to itself, meant for duration modifiers like damage over time
+	DurationModifiers,
+	// Every target adds and removes GameplayTag in turn
+	TagChurn,
+	// Every target writes its AttributeTag struct attribute back, forcing it to replicate
+	StructAttributeEdits,
+};
+
+USTRUCT()
+struct FSimpleNetBenchmarkSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	ESimpleNetBenchmarkScenario Scenario = ESimpleNetBenchmarkScenario::ActivationStorm;
+
+	/* How long the benchmark runs in seconds. */
+	UPROPERTY()
+	float Duration = 30.0f;
+
+	/* How many operations each target performs per second. */
+	UPROPERTY()
+	float OperationsPerSecond = 10.0f;
+
+	/* How many ability components are driven. 0 drives every ability component in the world. */
+	UPROPERTY()
+	int32 MaxTargets = 0;
+
+	UPROPERTY()
+	TSubclassOf<USimpleGameplayAbility> AbilityClass;
+
+	/* If true, ActivationStorm uses ActivationPolicy instead of the ability class's own policy. */
+	UPROPERTY()
+	bool OverrideActivationPolicy = false;
+
+	UPROPERTY()
+	EAbilityActivationPolicy ActivationPolicy = EAbilityActivationPolicy::LocalOnly;
+
+	UPROPERTY()
+	TSubclassOf<USimpleAttributeModifier> ModifierClass;
+
+	UPROPERTY()
+	FGameplayTag GameplayTag;
+
+	UPROPERTY()
+	FGameplayTag AttributeTag;
+};
+
+/**
+ * Drives a scripted load on the server's ability components and measures what it costs: bytes sent to each
+ * connection, RPCs sent per function and the time spent inside the ability component calls.
+ * Results are written as JSON to Saved/Profiling/SimpleGAS so runs can be compared.
+ * Start it on the server with the SimpleGAS.Benchmark console command while clients are connected (e.g. PIE with several players).
+ * Not available in shipping builds: the subsystem is never created there and the console command doesn't exist.
+ */
+UCLASS()
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleNetBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/* Starts the benchmark. Returns false if this isn't the server, a benchmark is already running or the settings are missing something. */
+	bool StartBenchmark(const FSimpleNetBenchmarkSettings& InSettings);
+
+	/* Stops the benchmark early and writes the results gathered so far. */
+	void StopBenchmark();
+
+	bool IsRunning() const { return Running; }
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	void DriveTarget(USimpleGameplayAbilityComponent* Target, int32 NumOperations);
+	void SampleConnections();
+	void WriteResults(double ElapsedTime);
+
+#if !UE_BUILD_SHIPPING
+	void OnSendRPC(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& BlockSendRPC);
+#endif
+
+	struct FConnectionSample
+	{
+		FString Name;
+		int64 StartOutBytes = 0;
+		int64 LastOutBytes = 0;
+	};
+
+	FSimpleNetBenchmarkSettings Settings;
+	TArray<TWeakObjectPtr<USimpleGameplayAbilityComponent>> Targets;
+	TMap<TWeakObjectPtr<UNetConnection>, FConnectionSample> ConnectionSamples;
+	TMap<FName, int32> RPCCounts;
+
+	bool Running = false;
+	bool IsCountingRPCs = false;
+	double StartTime = 0.0;
+	double OperationBudget = 0.0;
+
+	int32 Operations = 0;
+	int32 FailedOperations = 0;
+	uint64 ComponentCycles = 0;
+	uint64 SchedulerCycles = 0;
+	int32 PeakScheduledModifiers = 0;
+	double FrameTimeSum = 0.0;
+	int32 Frames = 0;
+};
@@ -0,0 +1,214 @@
+#include "SimpleNetworkClockComponent.h"
+
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "SimpleGameplayAbilitySystem/Module/SimpleGameplayAbilitySystem.h"
+
+// How much of the difference between the predicted and the measured offset is turned into drift each sync
+static constexpr double DriftCorrectionGain = 0.25;
+
+USimpleNetworkClockComponent::USimpleNetworkClockComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void USimpleNetworkClockComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Only the owning client samples, the server just answers
+	if (GetNetMode() != NM_Client || !GetOwner() || !GetOwner()->HasLocalNetOwner())
+	{
+		return;
+	}
+
+	Samples.Reserve(SampleWindowSize);
+	SendTimeRequest();
+}
+
+void USimpleNetworkClockComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (GetWorld())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(SyncTimerHandle);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+double USimpleNetworkClockComponent::GetServerTime() const
+{
+	const UWorld* World = GetWorld();
+
+	if (!World)
+	{
+		return 0.0;
+	}
+
+	if (GetNetMode() != NM_Client)
+	{
+		return World->GetTimeSeconds();
+	}
+
+	if (!HasSynced)
+	{
+		const AGameStateBase* GameState = World->GetGameState();
+		return GameState ? GameState->GetServerWorldTimeSeconds() : World->GetTimeSeconds();
+	}
+
+	const double LocalTime = GetLocalTime();
+	return LocalTime + GetCorrectedOffset(LocalTime);
+}
+
+bool USimpleNetworkClockComponent::IsSynchronized() const
+{
+	return GetNetMode() != NM_Client || HasSynced;
+}
+
+USimpleNetworkClockComponent* USimpleNetworkClockComponent::FindLocalClock(const UWorld* World)
+{
+	if (!World || World->GetNetMode() != NM_Client)
+	{
+		return nullptr;
+	}
+
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	return PlayerController ? PlayerController->FindComponentByClass<USimpleNetworkClockComponent>() : nullptr;
+}
+
+void USimpleNetworkClockComponent::SendTimeRequest()
+{
+	ServerRequestTime(GetLocalTime());
+
+	const float Interval = Samples.Num() < SampleWindowSize ? InitialSyncInterval : SyncInterval;
+	GetWorld()->GetTimerManager().SetTimer(SyncTimerHandle, this, &USimpleNetworkClockComponent::SendTimeRequest, Interval, false);
+}
+
+void USimpleNetworkClockComponent::ServerRequestTime_Implementation(const double ClientSendTime)
+{
+	// Requests are unreliable and cheap to answer, but there's no reason to answer more than one per frame
+	if (LastTimeRequestFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	LastTimeRequestFrame = GFrameCounter;
+	ClientReceiveTime(ClientSendTime, GetWorld()->GetTimeSeconds());
+}
+
+void USimpleNetworkClockComponent::ClientReceiveTime_Implementation(const double ClientSendTime, const double ServerTime)
+{
+	const double LocalTime = GetLocalTime();
+	const double SampleRoundTripTime = LocalTime - ClientSendTime;
+
+	if (SampleRoundTripTime < 0.0)
+	{
+		SIMPLE_LOG(this, TEXT("[USimpleNetworkClockComponent::ClientReceiveTime]: Ignoring a time sample with a negative round trip time."));
+		return;
+	}
+
+	// Assume the reply took half the round trip to get here
+	FNetworkClockSample Sample;
+	Sample.RoundTripTime = SampleRoundTripTime;
+	Sample.Offset = ServerTime + SampleRoundTripTime * 0.5 - LocalTime;
+	Sample.LocalTime = LocalTime;
+
+	AddSample(Sample);
+}
+
+void USimpleNetworkClockComponent::AddSample(const FNetworkClockSample& Sample)
+{
+	if (Samples.Num() < SampleWindowSize)
+	{
+		Samples.Add(Sample);
+	}
+	else
+	{
+		Samples[NextSampleIndex] = Sample;
+	}
+
+	NextSampleIndex = (NextSampleIndex + 1) % SampleWindowSize;
+
+	RoundTripTime = Samples[0].RoundTripTime;
+
+	for (const FNetworkClockSample& WindowSample : Samples)
+	{
+		RoundTripTime = FMath::Min(RoundTripTime, WindowSample.RoundTripTime);
+	}
+
+	const double LocalTime = Sample.LocalTime;
+	const double NewTargetOffset = GetFilteredOffset(LocalTime);
+
+	if (!HasSynced)
+	{
+		TargetOffset = NewTargetOffset;
+		TargetOffsetTime = LocalTime;
+		SlewError = 0.0;
+		HasSynced = true;
+		OnClockResynced.Broadcast();
+		return;
+	}
+
+	const double CurrentOffset = GetCorrectedOffset(LocalTime);
+
+	// Once the window is full the filtered offset is stable enough to tell drift apart from noise
+	const double TimeSinceLastTarget = LocalTime - TargetOffsetTime;
+
+	if (Samples.Num() == SampleWindowSize && TimeSinceLastTarget > UE_KINDA_SMALL_NUMBER)
+	{
+		const double PredictedOffset = TargetOffset + DriftRate * TimeSinceLastTarget;
+		DriftRate += DriftCorrectionGain * (NewTargetOffset - PredictedOffset) / TimeSinceLastTarget;
+		DriftRate = FMath::Clamp(DriftRate, -MaxDriftRate, MaxDriftRate);
+	}
+
+	TargetOffset = NewTargetOffset;
+	TargetOffsetTime = LocalTime;
+
+	if (FMath::Abs(CurrentOffset - NewTargetOffset) > SnapThreshold)
+	{
+		SlewError = 0.0;
+		OnClockResynced.Broadcast();
+		return;
+	}
+
+	// Keep reporting the old estimate and slew it towards the new one so the server time doesn't jump
+	SlewError = CurrentOffset - NewTargetOffset;
+}
+
+double USimpleNetworkClockComponent::GetFilteredOffset(const double LocalTime) const
+{
+	// Samples with a low round trip time were the least delayed by queuing, so their offsets are the most accurate
+	TArray<FNetworkClockSample> SortedSamples = Samples;
+	SortedSamples.Sort([](const FNetworkClockSample& A, const FNetworkClockSample& B)
+	{
+		return A.RoundTripTime < B.RoundTripTime;
+	});
+
+	const int32 NumBestSamples = FMath::Max(SortedSamples.Num() / 3, 1);
+	double OffsetSum = 0.0;
+
+	for (int32 i = 0; i < NumBestSamples; i++)
+	{
+		// Older samples are moved forward by the drift since they were taken
+		OffsetSum += SortedSamples[i].Offset + DriftRate * (LocalTime - SortedSamples[i].LocalTime);
+	}
+
+	return OffsetSum / NumBestSamples;
+}
+
+double USimpleNetworkClockComponent::GetCorrectedOffset(const double LocalTime) const
+{
+	const double TimeSinceTarget = LocalTime - TargetOffsetTime;
+	const double DriftedOffset = TargetOffset + DriftRate * TimeSinceTarget;
+
+	// The slew error shrinks by at most MaxSlewRate seconds per second until it's gone
+	const double RemainingSlewError = FMath::Max(FMath::Abs(SlewError) - MaxSlewRate * TimeSinceTarget, 0.0);
+
+	return DriftedOffset + FMath::Sign(SlewError) * RemainingSlewError;
+}
+
+double USimpleNetworkClockComponent::GetLocalTime() const
+{
+	return GetWorld()->GetTimeSeconds();
+}
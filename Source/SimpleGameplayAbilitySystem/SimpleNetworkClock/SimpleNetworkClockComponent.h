@@ -0,0 +1,117 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "SimpleNetworkClockComponent.generated.h"
+
+DECLARE_MULTICAST_DELEGATE(FOnNetworkClockResynced);
+
+struct FNetworkClockSample
+{
+	double RoundTripTime = 0.0;
+	// Server time minus local time, measured at LocalTime
+	double Offset = 0.0;
+	double LocalTime = 0.0;
+};
+
+/**
+ * Estimates the server time on a client by timing small unreliable requests to the server, NTP style.
+ * The offset is taken from the samples with the lowest round trip time, drift between the two clocks is tracked, and
+ * small corrections are slewed in so the estimated server time never jumps.
+ * Add it to the PlayerController. Ability components on the same client use it in GetServerTime once it has synced.
+ */
+UCLASS(Blueprintable, ClassGroup=(AbilityComponent), meta=(BlueprintSpawnableComponent))
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleNetworkClockComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	USimpleNetworkClockComponent();
+
+	/* Properties */
+
+	/* Seconds between time requests once the sample window is full. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NetworkClock", meta = (ClampMin = "0.1"))
+	float SyncInterval = 2.0f;
+
+	/* Seconds between time requests while the sample window is filling up. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NetworkClock", meta = (ClampMin = "0.01"))
+	float InitialSyncInterval = 0.2f;
+
+	/* How many of the most recent samples are kept. The offset is averaged from the third with the lowest round trip time. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NetworkClock", meta = (ClampMin = "1"))
+	int32 SampleWindowSize = 12;
+
+	/* The most the clock speeds up or slows down to correct a small error, in seconds per second. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NetworkClock", meta = (ClampMin = "0.001", ClampMax = "0.5"))
+	float MaxSlewRate = 0.05f;
+
+	/* Errors bigger than this (in seconds) are corrected by jumping straight to the new estimate. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NetworkClock", meta = (ClampMin = "0"))
+	float SnapThreshold = 0.25f;
+
+	/* The largest drift between the client and server clocks that is corrected for, in seconds per second. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "NetworkClock", meta = (ClampMin = "0", ClampMax = "0.1"))
+	float MaxDriftRate = 0.01f;
+
+	/* Broadcast when the estimate jumps instead of slewing, e.g. on the first sync or after a hitch. */
+	FOnNetworkClockResynced OnClockResynced;
+
+	/* Functions */
+
+	/**
+	 * Returns the server time on the server and the synchronised estimate of it on the owning client.
+	 * Falls back to the game state's server time until the clock has synced.
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "NetworkClock")
+	double GetServerTime() const;
+
+	/* True on the server, and on the owning client once the first time sample has arrived. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "NetworkClock")
+	bool IsSynchronized() const;
+
+	/* The lowest round trip time in the current sample window, in seconds. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "NetworkClock")
+	float GetRoundTripTime() const { return RoundTripTime; }
+
+	/* The estimated drift of the server clock relative to the local clock, in seconds per second. */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "NetworkClock")
+	float GetDriftRate() const { return DriftRate; }
+
+	/* Returns the clock on the first local PlayerController, or null if this isn't a client or there is none. */
+	static USimpleNetworkClockComponent* FindLocalClock(const UWorld* World);
+
+	/* Overrides */
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+protected:
+	UFUNCTION(Server, Unreliable)
+	void ServerRequestTime(double ClientSendTime);
+
+	UFUNCTION(Client, Unreliable)
+	void ClientReceiveTime(double ClientSendTime, double ServerTime);
+
+	void SendTimeRequest();
+	void AddSample(const FNetworkClockSample& Sample);
+	double GetFilteredOffset(double LocalTime) const;
+	double GetCorrectedOffset(double LocalTime) const;
+	double GetLocalTime() const;
+
+	TArray<FNetworkClockSample> Samples;
+	int32 NextSampleIndex = 0;
+
+	// The filtered offset, when it was measured and how fast it is drifting
+	double TargetOffset = 0.0;
+	double TargetOffsetTime = 0.0;
+	double DriftRate = 0.0;
+
+	// The difference between the previous estimate and the new target that is being slewed out
+	double SlewError = 0.0;
+
+	double RoundTripTime = 0.0;
+	bool HasSynced = false;
+	uint64 LastTimeRequestFrame = MAX_uint64;
+	FTimerHandle SyncTimerHandle;
+};
@@ -0,0 +1,51 @@
+#include "SimpleTimerSubsystem.h"
+
+#include "GameFramework/GameStateBase.h"
+
+uint64 USimpleTimerSubsystem::ScheduleTimer(const double FireTime, const FSimpleTimerDelegate& Callback)
+{
+	return TimerWheel.ScheduleTimer(FireTime, Callback);
+}
+
+void USimpleTimerSubsystem::CancelTimer(const uint64 TimerHandle)
+{
+	TimerWheel.CancelTimer(TimerHandle);
+}
+
+double USimpleTimerSubsystem::GetTimerTime() const
+{
+	const UWorld* World = GetWorld();
+
+	if (!World)
+	{
+		return 0.0;
+	}
+
+	if (const AGameStateBase* GameState = World->GetGameState())
+	{
+		return GameState->GetServerWorldTimeSeconds();
+	}
+
+	return World->GetTimeSeconds();
+}
+
+void USimpleTimerSubsystem::Deinitialize()
+{
+	TimerWheel.Reset();
+	Super::Deinitialize();
+}
+
+void USimpleTimerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (TimerWheel.Num() > 0)
+	{
+		TimerWheel.Advance(GetTimerTime());
+	}
+}
+
+TStatId USimpleTimerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USimpleTimerSubsystem, STATGROUP_Tickables);
+}
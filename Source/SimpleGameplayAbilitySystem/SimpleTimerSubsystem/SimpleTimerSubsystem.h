@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SimpleTimerWheel.h"
+#include "SimpleTimerSubsystem.generated.h"
+
+/**
+ * Owns a single timer wheel per world that ability components use to schedule expiry callbacks (e.g. cooldowns)
+ * instead of polling every frame. Timers are scheduled in server time so they line up with replicated end times.
+ */
+UCLASS()
+class SIMPLEGAMEPLAYABILITYSYSTEM_API USimpleTimerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Schedules a callback to fire once the server time reaches FireTime.
+	 * @return A handle used to cancel the timer
+	 */
+	uint64 ScheduleTimer(double FireTime, const FSimpleTimerDelegate& Callback);
+
+	void CancelTimer(uint64 TimerHandle);
+
+	/* The time the timer wheel runs on. Uses GetServerWorldTimeSeconds() from the game state if there is one. */
+	double GetTimerTime() const;
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	FSimpleTimerWheel TimerWheel;
+};
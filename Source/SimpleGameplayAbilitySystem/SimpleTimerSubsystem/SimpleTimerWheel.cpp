@@ -0,0 +1,92 @@
+#include "SimpleTimerWheel.h"
+
+FSimpleTimerWheel::FSimpleTimerWheel(const int32 InSlotCount, const double InSlotDuration)
+{
+	Slots.SetNum(FMath::Max(InSlotCount, 1));
+	SlotDuration = FMath::Max(InSlotDuration, UE_KINDA_SMALL_NUMBER);
+}
+
+uint64 FSimpleTimerWheel::ScheduleTimer(const double FireTime, const FSimpleTimerDelegate& Callback)
+{
+	// Timers in the past go into the first slot that will still be visited
+	const int64 SlotTick = FMath::Max(GetSlotTick(FireTime), LastProcessedTick + 1);
+	const int32 SlotIndex = GetSlotIndex(SlotTick);
+
+	FTimerEntry NewEntry;
+	NewEntry.Handle = NextTimerHandle++;
+	NewEntry.FireTime = FireTime;
+	NewEntry.Callback = Callback;
+
+	Slots[SlotIndex].Add(NewEntry);
+	TimerSlotLookup.Add(NewEntry.Handle, SlotIndex);
+
+	return NewEntry.Handle;
+}
+
+bool FSimpleTimerWheel::CancelTimer(const uint64 TimerHandle)
+{
+	int32 SlotIndex;
+
+	if (!TimerSlotLookup.RemoveAndCopyValue(TimerHandle, SlotIndex))
+	{
+		return false;
+	}
+
+	Slots[SlotIndex].RemoveAllSwap([TimerHandle](const FTimerEntry& Entry) { return Entry.Handle == TimerHandle; });
+	return true;
+}
+
+void FSimpleTimerWheel::Advance(const double CurrentTime)
+{
+	const int64 CurrentTick = GetSlotTick(CurrentTime);
+
+	if (LastProcessedTick == INDEX_NONE)
+	{
+		LastProcessedTick = CurrentTick - 1;
+	}
+
+	if (CurrentTick <= LastProcessedTick)
+	{
+		return;
+	}
+
+	// If more than a full revolution elapsed we only need to visit every slot once
+	const int64 FirstTick = FMath::Max(LastProcessedTick + 1, CurrentTick - Slots.Num() + 1);
+	TArray<FSimpleTimerDelegate> ExpiredCallbacks;
+
+	for (int64 SlotTick = FirstTick; SlotTick <= CurrentTick; SlotTick++)
+	{
+		TArray<FTimerEntry>& Slot = Slots[GetSlotIndex(SlotTick)];
+
+		for (int32 i = Slot.Num() - 1; i >= 0; i--)
+		{
+			if (Slot[i].FireTime > CurrentTime)
+			{
+				continue;
+			}
+
+			ExpiredCallbacks.Add(MoveTemp(Slot[i].Callback));
+			TimerSlotLookup.Remove(Slot[i].Handle);
+			Slot.RemoveAtSwap(i);
+		}
+	}
+
+	LastProcessedTick = CurrentTick - 1;
+
+	// Callbacks are called after the wheel is updated so they can safely schedule new timers
+	for (const FSimpleTimerDelegate& ExpiredCallback : ExpiredCallbacks)
+	{
+		ExpiredCallback.ExecuteIfBound();
+	}
+}
+
+void FSimpleTimerWheel::Reset()
+{
+	for (TArray<FTimerEntry>& Slot : Slots)
+	{
+		Slot.Empty();
+	}
+
+	TimerSlotLookup.Empty();
+	LastProcessedTick = INDEX_NONE;
+}
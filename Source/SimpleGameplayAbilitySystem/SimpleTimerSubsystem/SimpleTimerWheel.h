@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_DELEGATE(FSimpleTimerDelegate);
+
+/**
+ * A hashed timer wheel. Timers are bucketed into fixed size time slots so advancing the wheel only visits the slots
+ * that elapsed since the last advance instead of every pending timer.
+ * Timers further away than one revolution of the wheel stay in their slot until their fire time is reached.
+ */
+class SIMPLEGAMEPLAYABILITYSYSTEM_API FSimpleTimerWheel
+{
+public:
+	explicit FSimpleTimerWheel(int32 InSlotCount = 256, double InSlotDuration = 0.05);
+
+	/**
+	 * Schedules a callback to be called once the wheel is advanced past FireTime.
+	 * @return A handle that can be used to cancel the timer. Never 0.
+	 */
+	uint64 ScheduleTimer(double FireTime, const FSimpleTimerDelegate& Callback);
+
+	/* Returns true if the timer was pending and has been removed. */
+	bool CancelTimer(uint64 TimerHandle);
+
+	/* Fires every timer with a fire time at or before CurrentTime. */
+	void Advance(double CurrentTime);
+
+	int32 Num() const { return TimerSlotLookup.Num(); }
+
+	void Reset();
+
+private:
+	struct FTimerEntry
+	{
+		uint64 Handle;
+		double FireTime;
+		FSimpleTimerDelegate Callback;
+	};
+
+	int64 GetSlotTick(const double Time) const { return FMath::FloorToInt64(Time / SlotDuration); }
+	int32 GetSlotIndex(const int64 SlotTick) const { return static_cast<int32>(SlotTick % Slots.Num()); }
+
+	TArray<TArray<FTimerEntry>> Slots;
+	TMap<uint64, int32> TimerSlotLookup;
+
+	double SlotDuration;
+
+	// The last slot that is fully in the past. The slot after it is still partially in the future and gets revisited.
+	int64 LastProcessedTick = INDEX_NONE;
+	uint64 NextTimerHandle = 1;
+};